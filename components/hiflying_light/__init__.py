@@ -1,32 +1,314 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.const import CONF_ID
+from esphome import automation
+import esphome.final_validate as fv
+from esphome.components import esp32, esp32_ble_tracker
+from esphome.const import CONF_ID, CONF_PLATFORM, CONF_TYPE
 
 DEPENDENCIES = ["esp32", "esp32_ble"]
 CODEOWNERS = ["@hiflying"]
+MULTI_CONF = True
 
 CONF_INSTANCE_ID = "instance_id"
 CONF_PACKET_INTERVAL = "packet_interval"
 CONF_PACKET_COUNT = "packet_count"
 CONF_COUNTER = "counter"
+CONF_BLOCKING = "blocking"
+CONF_RADIO_TASK = "radio_task"
+CONF_CRC_TABLE = "crc_table"
+CONF_COUNTER_LEASE = "counter_lease"
+CONF_RTC_COUNTER = "rtc_counter"
+CONF_ADVERTISING = "advertising"
+CONF_DRY_RUN = "dry_run"
+CONF_PROTOCOL = "protocol"
+CONF_SNIFFER = "sniffer"
+CONF_PRE_ENCODE = "pre_encode"
+CONF_SELF_TEST = "self_test"
+CONF_TRACE = "trace"
+CONF_REPEAT_POLICY = "repeat_policy"
+CONF_ADAPTIVE_REPEATS = "adaptive_repeats"
+CONF_COMPOUND_COMMANDS = "compound_commands"
+CONF_FRAMING = "framing"
+CONF_PREEMPTION = "preemption"
+CONF_STALE_DEADLINE = "stale_deadline"
+CONF_REPEATS = "repeats"
+CONF_INTERVAL = "interval"
+CONF_PRIORITY = "priority"
+CONF_REMOTE_ADDRESS = "remote_address"
+
+CONF_ENTRIES = "entries"
+CONF_COMMAND = "command"
+CONF_PARAM = "param"
+
+CRC_TABLES = ["full", "nibble"]
+ADVERTISING_MODES = ["legacy", "extended"]
+
+# 支援 BLE 5 多集擴展廣播的晶片
+EXT_ADV_VARIANTS = [
+    esp32.const.VARIANT_ESP32C3,
+    esp32.const.VARIANT_ESP32S3,
+    esp32.const.VARIANT_ESP32C6,
+    esp32.const.VARIANT_ESP32H2,
+]
+
+
+def _validate_advertising(config):
+    if config[CONF_ADVERTISING] == "extended":
+        variant = esp32.get_esp32_variant()
+        if variant not in EXT_ADV_VARIANTS:
+            raise cv.Invalid(
+                f"Extended advertising is not supported on {variant}",
+                path=[CONF_ADVERTISING],
+            )
+    return config
+
 
 hiflying_light_ns = cg.esphome_ns.namespace("hiflying_light")
 HiFlyingLightComponent = hiflying_light_ns.class_(
     "HiFlyingLightComponent", cg.Component
 )
+SendSceneAction = hiflying_light_ns.class_("SendSceneAction", automation.Action)
+HiFlyingLightHub = hiflying_light_ns.class_("HiFlyingLightHub", cg.Component)
+HiFlyingRadio = hiflying_light_ns.class_("HiFlyingRadio")
+HiFlyingLightSniffer = hiflying_light_ns.class_(
+    "HiFlyingLightSniffer", esp32_ble_tracker.ESPBTDeviceListener
+)
+
+HiFlyingProtocol = hiflying_light_ns.enum("HiFlyingProtocol")
+PROTOCOLS = {
+    "auto": HiFlyingProtocol.PROTOCOL_AUTO,
+    "hf": HiFlyingProtocol.PROTOCOL_HF,
+    "deli16": HiFlyingProtocol.PROTOCOL_DELI16,
+    "both": HiFlyingProtocol.PROTOCOL_BOTH,
+}
+
+PreEncodeMode = hiflying_light_ns.enum("PreEncodeMode")
+PRE_ENCODE_MODES = {
+    "none": PreEncodeMode.PRE_ENCODE_NONE,
+    "on_off": PreEncodeMode.PRE_ENCODE_ON_OFF,
+    "last_brightness": PreEncodeMode.PRE_ENCODE_LAST_BRIGHTNESS,
+}
+
+# AD 資料封裝策略 (uuid_list 以外的策略只在使用時編譯)
+AdvFraming = hiflying_light_ns.enum("AdvFraming")
+FRAMINGS = {
+    "uuid_list": AdvFraming.FRAMING_UUID_LIST,
+    "raw": AdvFraming.FRAMING_RAW,
+    "manufacturer": AdvFraming.FRAMING_MANUFACTURER,
+}
+FRAMING_DEFINES = {
+    "raw": "USE_HIFLYING_LIGHT_FRAMING_RAW",
+    "manufacturer": "USE_HIFLYING_LIGHT_FRAMING_MANUFACTURER",
+}
+
+HiFlyingCommand = hiflying_light_ns.enum("HiFlyingCommand")
+COMMANDS = {
+    "pair": HiFlyingCommand.COMMAND_PAIR,
+    "off": HiFlyingCommand.COMMAND_OFF,
+    "on": HiFlyingCommand.COMMAND_ON,
+    "brightness": HiFlyingCommand.COMMAND_BRIGHTNESS,
+    "color_temperature": HiFlyingCommand.COMMAND_COLOR_TEMP,
+}
+
+# 每種命令的重複策略，未設定的欄位沿用 packet_count / packet_interval
+# 優先級: 佇列已滿時先丟棄較低的命令 (預設配對/開/關為 1，亮度/色溫為 0)
+CRITICAL_COMMANDS = ["pair", "off", "on"]
+
+# 發送間隔存在 uint16_t 欄位中 (RepeatPolicy、TxJob、RadioCommand)，超過 65535 ms 會迴繞
+PACKET_INTERVAL_SCHEMA = cv.All(
+    cv.positive_time_period_milliseconds,
+    cv.Range(max=cv.TimePeriod(milliseconds=65535)),
+)
 
-CONFIG_SCHEMA = cv.Schema(
+REPEAT_POLICY_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_REPEATS): cv.int_range(min=1, max=10),
+        cv.Optional(CONF_INTERVAL): PACKET_INTERVAL_SCHEMA,
+        cv.Optional(CONF_PRIORITY): cv.int_range(min=0, max=3),
+    }
+)
+
+# 被動監聽遙控器命令以更新狀態快取 (需要 esp32_ble_tracker)
+SNIFFER_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(HiFlyingLightSniffer),
+        cv.Required(CONF_REMOTE_ADDRESS): cv.hex_uint16_t,
+    }
+).extend(esp32_ble_tracker.ESP_BLE_DEVICE_SCHEMA)
+
+LIGHT_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(HiFlyingLightComponent),
         cv.Optional(CONF_INSTANCE_ID, default=1): cv.int_range(min=1, max=99),
-        cv.Optional(CONF_PACKET_INTERVAL, default="10ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_PACKET_INTERVAL, default="10ms"): PACKET_INTERVAL_SCHEMA,
         cv.Optional(CONF_PACKET_COUNT, default=3): cv.int_range(min=1, max=10),
         cv.Optional(CONF_COUNTER, default=1): cv.int_range(min=1, max=65535),
+        cv.Optional(CONF_COUNTER_LEASE, default=64): cv.int_range(min=1, max=1024),
+        cv.Optional(CONF_RTC_COUNTER, default=False): cv.boolean,
+        cv.Optional(CONF_BLOCKING, default=False): cv.boolean,
+        cv.Optional(CONF_RADIO_TASK, default=False): cv.boolean,
+        cv.Optional(CONF_CRC_TABLE): cv.invalid(
+            f"{CONF_CRC_TABLE} is shared by all instances, set it on the entry with 'type: radio'"
+        ),
+        cv.Optional(CONF_ADVERTISING): cv.invalid(
+            f"{CONF_ADVERTISING} is shared by all instances, set it on the entry with 'type: radio'"
+        ),
+        cv.Optional(CONF_DRY_RUN): cv.invalid(
+            f"{CONF_DRY_RUN} is shared by all instances, set it on the entry with 'type: radio'"
+        ),
+        cv.Optional(CONF_PROTOCOL, default="both"): cv.enum(PROTOCOLS, lower=True),
+        cv.Optional(CONF_SNIFFER): SNIFFER_SCHEMA,
+        cv.Optional(CONF_PRE_ENCODE, default="none"): cv.enum(PRE_ENCODE_MODES, lower=True),
+        cv.Optional(CONF_SELF_TEST): cv.invalid(
+            f"{CONF_SELF_TEST} is shared by all instances, set it on the entry with 'type: radio'"
+        ),
+        cv.Optional(CONF_TRACE): cv.invalid(
+            f"{CONF_TRACE} is shared by all instances, set it on the entry with 'type: radio'"
+        ),
+        cv.Optional(CONF_REPEAT_POLICY): cv.Schema(
+            {cv.Optional(command): REPEAT_POLICY_SCHEMA for command in COMMANDS}
+        ),
+        cv.Optional(CONF_ADAPTIVE_REPEATS, default=False): cv.boolean,
+        cv.Optional(CONF_COMPOUND_COMMANDS, default=True): cv.boolean,
+        cv.Optional(CONF_FRAMING, default="uuid_list"): cv.enum(FRAMINGS, lower=True),
+        cv.Optional(CONF_PREEMPTION, default=True): cv.boolean,
+        cv.Optional(CONF_STALE_DEADLINE, default="100ms"): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(max=cv.TimePeriod(milliseconds=10000)),
+        ),
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
+# 集線器: 一個元件驅動多個燈具 (燈具由 light 平台以 hub_id + instance_id 加入)
+HUB_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(HiFlyingLightHub),
+        cv.Optional(CONF_PACKET_INTERVAL, default="10ms"): PACKET_INTERVAL_SCHEMA,
+        cv.Optional(CONF_PACKET_COUNT, default=3): cv.int_range(min=1, max=10),
+        cv.Optional(CONF_COUNTER, default=1): cv.int_range(min=1, max=65535),
+        cv.Optional(CONF_COUNTER_LEASE, default=64): cv.int_range(min=1, max=1024),
+        cv.Optional(CONF_FRAMING, default="uuid_list"): cv.enum(FRAMINGS, lower=True),
+        cv.Optional(CONF_DRY_RUN): cv.invalid(
+            f"{CONF_DRY_RUN} is shared by all instances, set it on the entry with 'type: radio'"
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+# 所有實例共用的射頻設定 (編譯期選項與單例仲裁器)，最多一個
+RADIO_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Optional(CONF_CRC_TABLE, default="full"): cv.one_of(*CRC_TABLES, lower=True),
+            cv.Optional(CONF_ADVERTISING, default="legacy"): cv.one_of(*ADVERTISING_MODES, lower=True),
+            cv.Optional(CONF_DRY_RUN, default=False): cv.boolean,
+            cv.Optional(CONF_SELF_TEST, default=False): cv.boolean,
+            cv.Optional(CONF_TRACE, default=False): cv.boolean,
+        }
+    ),
+    _validate_advertising,
+)
+
+CONFIG_SCHEMA = cv.typed_schema(
+    {"light": LIGHT_SCHEMA, "hub": HUB_SCHEMA, "radio": RADIO_SCHEMA},
+    key=CONF_TYPE,
+    default_type="light",
+    lower=True,
+)
+
+
+# 通道、遺失計數與 MAC 地址都以 instance_id 區分，獨立元件與集線器燈具 (light 平台的 hub_id) 不可重複
+def _instance_ids(full_config):
+    ids = [
+        (c[CONF_INSTANCE_ID], c[CONF_ID])
+        for c in full_config["hiflying_light"]
+        if c[CONF_TYPE] == "light"
+    ]
+    for lamp in full_config.get("light", []):
+        if lamp.get(CONF_PLATFORM) == "hiflying_light" and "hub_id" in lamp:
+            ids.append((lamp[CONF_INSTANCE_ID], lamp["hub_id"]))
+    return ids
+
+
+def _final_validate(config):
+    full_config = fv.full_config.get()
+    configs = full_config["hiflying_light"]
+    if config[CONF_TYPE] == "radio" and sum(c[CONF_TYPE] == "radio" for c in configs) > 1:
+        raise cv.Invalid("Only one hiflying_light entry may use 'type: radio'")
+    # 射頻任務由所有實例共用，任務擁有發送狀態機時 blocking 無法在 loop 中推進它
+    if (
+        config[CONF_TYPE] == "light"
+        and config[CONF_BLOCKING]
+        and any(c[CONF_TYPE] == "light" and c[CONF_RADIO_TASK] for c in configs)
+    ):
+        raise cv.Invalid(
+            f"{CONF_BLOCKING} cannot be combined with {CONF_RADIO_TASK} on any instance",
+            path=[CONF_BLOCKING],
+        )
+    ids = _instance_ids(full_config)
+    if config[CONF_TYPE] == "light":
+        own = [config[CONF_INSTANCE_ID]]
+    elif config[CONF_TYPE] == "hub":
+        own = [instance_id for instance_id, owner in ids if owner == config[CONF_ID]]
+    else:
+        own = []
+    for instance_id in own:
+        if sum(other == instance_id for other, _ in ids) > 1:
+            raise cv.Invalid(
+                f"{CONF_INSTANCE_ID} {instance_id} is used by more than one light, "
+                "each lamp needs its own lane, counter and MAC address",
+                path=[CONF_INSTANCE_ID] if config[CONF_TYPE] == "light" else [],
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
+async def radio_to_code(config):
+    radio = cg.MockObj(f"{HiFlyingRadio}::get()", "->")
+    # dry_run: 所有實例共用模擬廣播器，需在任何元件 setup() 之前設定
+    if config[CONF_DRY_RUN]:
+        cg.add(radio.set_dry_run(True))
+    # CRC 查表大小 (nibble: 16 項，節省 flash)
+    if config[CONF_CRC_TABLE] == "nibble":
+        cg.add_define("USE_HIFLYING_LIGHT_CRC_NIBBLE_TABLE")
+    # 編碼器的差分自我測試，第一個燈具實例 setup() 時執行一次
+    if config[CONF_SELF_TEST]:
+        cg.add_define("USE_HIFLYING_LIGHT_SELF_TEST")
+    # 發送路徑的二進位封包追蹤 (取代 VERY_VERBOSE 的十六進位日誌)，仲裁器只有一個環形緩衝區
+    if config[CONF_TRACE]:
+        cg.add_define("USE_HIFLYING_LIGHT_TRACE")
+
+    # BLE 5 擴展廣播: HF 與 Deli16 在兩個廣播集上同時發送
+    # 控制器回報失敗時只使用一個擴展廣播集，集 0 無法建立時才改用傳統廣播，因此同時保留 BLE 4.2 的廣播 API
+    if config[CONF_ADVERTISING] == "extended":
+        cg.add_define("USE_HIFLYING_LIGHT_EXT_ADV")
+        esp32.add_idf_sdkconfig_option("CONFIG_BT_BLE_50_FEATURES_SUPPORTED", True)
+        esp32.add_idf_sdkconfig_option("CONFIG_BT_BLE_42_FEATURES_SUPPORTED", True)
+        cg.add(radio.set_extended_advertising(True))
+
+
+async def hub_to_code(config):
+    cg.add_define("USE_HIFLYING_LIGHT_HUB")
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_packet_interval(config[CONF_PACKET_INTERVAL]))
+    cg.add(var.set_packet_count(config[CONF_PACKET_COUNT]))
+    cg.add(var.set_counter(config[CONF_COUNTER]))
+    cg.add(var.set_counter_lease(config[CONF_COUNTER_LEASE]))
+    cg.add(var.set_framing(config[CONF_FRAMING]))
+    if define := FRAMING_DEFINES.get(str(config[CONF_FRAMING])):
+        cg.add_define(define)
+
 
 async def to_code(config):
+    if config[CONF_TYPE] == "hub":
+        await hub_to_code(config)
+        return
+    if config[CONF_TYPE] == "radio":
+        await radio_to_code(config)
+        return
+
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
 
@@ -36,4 +318,65 @@ async def to_code(config):
     # 設置封包參數
     cg.add(var.set_packet_interval(config[CONF_PACKET_INTERVAL]))
     cg.add(var.set_packet_count(config[CONF_PACKET_COUNT]))
-    cg.add(var.set_counter(config[CONF_COUNTER])) 
\ No newline at end of file
+    cg.add(var.set_counter(config[CONF_COUNTER]))
+    cg.add(var.set_counter_lease(config[CONF_COUNTER_LEASE]))
+    # RTC 計數器儲存區只在有實例使用時編譯，是否使用由各實例決定
+    if config[CONF_RTC_COUNTER]:
+        cg.add_define("USE_HIFLYING_LIGHT_RTC_COUNTER")
+        cg.add(var.set_rtc_counter(True))
+    cg.add(var.set_blocking(config[CONF_BLOCKING]))
+    cg.add(var.set_radio_task(config[CONF_RADIO_TASK]))
+    cg.add(var.set_protocol(config[CONF_PROTOCOL]))
+    cg.add(var.set_pre_encode(config[CONF_PRE_ENCODE]))
+    for command, policy in config.get(CONF_REPEAT_POLICY, {}).items():
+        interval = policy.get(CONF_INTERVAL)
+        cg.add(
+            var.set_repeat_policy(
+                COMMANDS[command],
+                policy.get(CONF_REPEATS, 0),
+                interval.total_milliseconds if interval is not None else 0,
+                policy.get(CONF_PRIORITY, 1 if command in CRITICAL_COMMANDS else 0),
+            )
+        )
+    cg.add(var.set_adaptive_repeats(config[CONF_ADAPTIVE_REPEATS]))
+    cg.add(var.set_compound_commands(config[CONF_COMPOUND_COMMANDS]))
+    cg.add(var.set_framing(config[CONF_FRAMING]))
+    cg.add(var.set_preemption(config[CONF_PREEMPTION]))
+    cg.add(var.set_stale_deadline(config[CONF_STALE_DEADLINE]))
+    if define := FRAMING_DEFINES.get(str(config[CONF_FRAMING])):
+        cg.add_define(define)
+
+    if sniffer_config := config.get(CONF_SNIFFER):
+        cg.add_define("USE_HIFLYING_LIGHT_SNIFFER")
+        sniffer = cg.new_Pvariable(sniffer_config[CONF_ID], var)
+        await esp32_ble_tracker.register_ble_device(sniffer, sniffer_config)
+        cg.add(sniffer.set_remote_address(sniffer_config[CONF_REMOTE_ADDRESS]))
+
+
+# 多燈場景: 一次編碼所有燈具的封包，以單一交錯突發發送
+SCENE_ENTRY_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.use_id(HiFlyingLightComponent),
+        cv.Required(CONF_COMMAND): cv.enum(COMMANDS, lower=True),
+        cv.Optional(CONF_PARAM, default=0): cv.int_range(min=0, max=1000),
+    }
+)
+
+
+@automation.register_action(
+    "hiflying_light.send_scene",
+    SendSceneAction,
+    cv.Schema(
+        {
+            cv.Required(CONF_ENTRIES): cv.All(
+                cv.ensure_list(SCENE_ENTRY_SCHEMA), cv.Length(min=1)
+            ),
+        }
+    ),
+)
+async def send_scene_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    for entry in config[CONF_ENTRIES]:
+        light = await cg.get_variable(entry[CONF_ID])
+        cg.add(var.add_entry(light, entry[CONF_COMMAND], entry[CONF_PARAM]))
+    return var
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "esphome/core/automation.h"
+#include "hiflying_light.h"
+
+#include <vector>
+
+namespace esphome {
+namespace hiflying_light {
+
+// hiflying_light.send_scene: 以單一交錯突發發送多個燈具的命令
+template<typename... Ts> class SendSceneAction : public Action<Ts...> {
+ public:
+  void add_entry(HiFlyingLightComponent *light, HiFlyingCommand command, uint16_t param) {
+    this->entries_.push_back({light, command, param});
+  }
+
+  void play(Ts... x) override { HiFlyingLightComponent::send_scene(this->entries_); }
+
+ protected:
+  std::vector<SceneEntry> entries_;
+};
+
+}  // namespace hiflying_light
+}  // namespace esphome
@@ -1,25 +1,75 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import button
-from esphome.const import CONF_ID
+from esphome.const import CONF_ID, CONF_TYPE
 
-from . import HiFlyingLightComponent, hiflying_light_ns
+from . import CONF_INSTANCE_ID, HiFlyingLightComponent, HiFlyingLightHub, hiflying_light_ns
+
+CONF_HUB_ID = "hub_id"
 
 HiFlyingLightPairButton = hiflying_light_ns.class_(
     "HiFlyingLightPairButton", button.Button
 )
+HiFlyingLightProbeButton = hiflying_light_ns.class_(
+    "HiFlyingLightProbeButton", HiFlyingLightPairButton
+)
+HiFlyingLightProbeConfirmButton = hiflying_light_ns.class_(
+    "HiFlyingLightProbeConfirmButton", HiFlyingLightPairButton
+)
+HiFlyingLightTraceDumpButton = hiflying_light_ns.class_(
+    "HiFlyingLightTraceDumpButton", HiFlyingLightPairButton
+)
+HiFlyingHubPairButton = hiflying_light_ns.class_(
+    "HiFlyingHubPairButton", button.Button
+)
+
+# pair: 配對; probe: 開始協議探測; probe_confirm: 燈具閃爍時按下保存探測結果;
+# trace_dump: 輸出封包追蹤 (需要 type: radio 項目的 trace: true); hub_pair: 配對集線器中的一個燈具
+BUTTON_TYPES = {
+    "pair": HiFlyingLightPairButton,
+    "probe": HiFlyingLightProbeButton,
+    "probe_confirm": HiFlyingLightProbeConfirmButton,
+    "trace_dump": HiFlyingLightTraceDumpButton,
+}
+
 
-CONFIG_SCHEMA = button.BUTTON_SCHEMA.extend(
+def _button_schema(button_class):
+    return button.BUTTON_SCHEMA.extend(
+        {
+            cv.GenerateID(): cv.declare_id(button_class),
+            cv.Required("hiflying_light_id"): cv.use_id(HiFlyingLightComponent),
+        }
+    )
+
+
+HUB_PAIR_SCHEMA = button.BUTTON_SCHEMA.extend(
     {
-        cv.GenerateID(): cv.declare_id(HiFlyingLightPairButton),
-        cv.Required("hiflying_light_id"): cv.use_id(HiFlyingLightComponent),
+        cv.GenerateID(): cv.declare_id(HiFlyingHubPairButton),
+        cv.Required(CONF_HUB_ID): cv.use_id(HiFlyingLightHub),
+        cv.Required(CONF_INSTANCE_ID): cv.int_range(min=1, max=99),
     }
 )
 
+CONFIG_SCHEMA = cv.typed_schema(
+    {
+        **{key: _button_schema(cls) for key, cls in BUTTON_TYPES.items()},
+        "hub_pair": HUB_PAIR_SCHEMA,
+    },
+    key=CONF_TYPE,
+    default_type="pair",
+    lower=True,
+)
+
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await button.register_button(var, config)
 
+    if config[CONF_TYPE] == "hub_pair":
+        hub = await cg.get_variable(config[CONF_HUB_ID])
+        cg.add(var.set_hub(hub))
+        cg.add(var.set_instance_id(config[CONF_INSTANCE_ID]))
+        return
+
     parent = await cg.get_variable(config["hiflying_light_id"])
-    cg.add(var.set_parent(parent)) 
\ No newline at end of file
+    cg.add(var.set_parent(parent))
@@ -0,0 +1,218 @@
+#include "hiflying_advertiser.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+
+#ifdef USE_ESP32
+#include <esp_gap_ble_api.h>
+#endif
+
+namespace esphome {
+namespace hiflying_light {
+
+static const char *const TAG = "hiflying_light.advertiser";
+
+void SimulatedAdvertiser::wait(uint32_t ms) {
+  if (this->virtual_clock_) {
+    this->clock_ += ms;
+  } else {
+    delay(ms);
+  }
+}
+
+// xorshift32: 不依賴硬體亂數，同樣的命令序列產生同樣的地址與幀
+uint32_t SimulatedAdvertiser::random() {
+  uint32_t x = this->random_state_;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  this->random_state_ = x;
+  return x;
+}
+
+void SimulatedAdvertiser::record_(SimEventType type, uint8_t set, const uint8_t *data, size_t length) {
+  SimEvent &event = this->events_[this->event_total_ % SIM_LOG_SIZE];
+  event.time = this->now();
+  event.type = type;
+  event.set = set;
+  event.length = length;
+  event.data.fill(0);
+  if (data != nullptr)
+    std::copy(data, data + length, event.data.begin());
+  this->event_total_++;
+}
+
+size_t SimulatedAdvertiser::event_count() const {
+  return this->event_total_ < SIM_LOG_SIZE ? this->event_total_ : SIM_LOG_SIZE;
+}
+
+const SimEvent &SimulatedAdvertiser::event(size_t index) const {
+  size_t first = this->event_total_ < SIM_LOG_SIZE ? 0 : this->event_total_ % SIM_LOG_SIZE;
+  return this->events_[(first + index) % SIM_LOG_SIZE];
+}
+
+void SimulatedAdvertiser::set_address(uint8_t set, const uint8_t *address) {
+  this->address_changes_++;
+  this->record_(SIM_ADDRESS, set, address, 6);
+}
+
+void SimulatedAdvertiser::set_payload(uint8_t set, const AdvFrame &frame, uint8_t length) {
+  if (set < SIM_MAX_SETS)
+    this->payload_lengths_[set] = length;
+  this->record_(SIM_PAYLOAD, set, frame.data(), length);
+}
+
+void SimulatedAdvertiser::start(uint8_t set) {
+  if (set >= SIM_MAX_SETS || this->active_[set])
+    return;
+  uint32_t now = this->now();
+  if (this->frames_ == 0)
+    this->first_start_ = now;
+  this->frames_++;
+  this->active_[set] = true;
+  this->started_at_[set] = now;
+  this->record_(SIM_START, set, nullptr, 0);
+}
+
+void SimulatedAdvertiser::stop(uint8_t set) {
+  if (set >= SIM_MAX_SETS || !this->active_[set])
+    return;
+  uint32_t duration = this->now() - this->started_at_[set];
+  this->active_[set] = false;
+  this->active_ms_ += duration;
+  // 開始時立即有一個廣播事件，之後以最短廣播間隔估算 (上限估計)
+  uint32_t events = 1 + duration * 1000 / (ADV_INTERVAL_MIN * 625);
+  this->airtime_us_ += events * ADV_CHANNELS * adv_pdu_airtime_us(this->payload_lengths_[set]);
+  this->record_(SIM_STOP, set, nullptr, 0);
+}
+
+float SimulatedAdvertiser::get_frames_per_second() const {
+  uint32_t elapsed = this->now() - this->first_start_;
+  if (this->frames_ == 0 || elapsed == 0)
+    return 0.0f;
+  return this->frames_ * 1000.0f / elapsed;
+}
+
+void SimulatedAdvertiser::reset() {
+  this->event_total_ = 0;
+  this->active_.fill(false);
+  this->frames_ = 0;
+  this->address_changes_ = 0;
+  this->airtime_us_ = 0;
+  this->active_ms_ = 0;
+}
+
+#ifdef USE_ESP32
+
+void LegacyAdvertiser::set_address(uint8_t /*set*/, const uint8_t *address) {
+  esp_bd_addr_t rand_addr;
+  std::copy(address, address + 6, rand_addr);
+  esp_ble_gap_set_rand_addr(rand_addr);
+}
+
+void LegacyAdvertiser::set_payload(uint8_t /*set*/, const AdvFrame &frame, uint8_t length) {
+  // config_adv_data_raw 會複製資料，幀本身保持不變
+  esp_ble_gap_config_adv_data_raw(const_cast<uint8_t *>(frame.data()), length);
+}
+
+void LegacyAdvertiser::start(uint8_t /*set*/) {
+  esp_ble_adv_params_t adv_params = {};
+  adv_params.adv_int_min = ADV_INTERVAL_MIN;
+  adv_params.adv_int_max = ADV_INTERVAL_MAX;
+  adv_params.adv_type = ADV_TYPE_NONCONN_IND;
+  adv_params.own_addr_type = BLE_ADDR_TYPE_RANDOM;  // 使用隨機地址
+  adv_params.channel_map = ADV_CHNL_ALL;
+  adv_params.adv_filter_policy = ADV_FILTER_ALLOW_SCAN_ANY_CON_ANY;
+  esp_ble_gap_start_advertising(&adv_params);
+}
+
+void LegacyAdvertiser::stop(uint8_t /*set*/) { esp_ble_gap_stop_advertising(); }
+
+#ifdef USE_HIFLYING_LIGHT_EXT_ADV
+bool ExtendedAdvertiser::setup() {
+  esp_ble_gap_ext_adv_params_t params = {};
+  params.type = ESP_BLE_GAP_SET_EXT_ADV_PROP_LEGACY_NONCONN;
+  params.interval_min = ADV_INTERVAL_MIN;
+  params.interval_max = ADV_INTERVAL_MAX;
+  params.channel_map = ADV_CHNL_ALL;
+  params.own_addr_type = BLE_ADDR_TYPE_RANDOM;
+  params.filter_policy = ADV_FILTER_ALLOW_SCAN_ANY_CON_ANY;
+  params.tx_power = ESP_BLE_GAP_EXT_ADV_TX_PWR_NO_PREFERENCE;
+  params.primary_phy = ESP_BLE_GAP_PRI_PHY_1M;
+  params.secondary_phy = ESP_BLE_GAP_PHY_1M;
+
+  // 同步的回傳值只表示命令已送往控制器，實際結果在 GAP 事件中回報 (見 gap_event_handler)
+  // 第一個集的命令沒有送出時控制器不受影響，回傳 false 由呼叫端銷毀這個物件
+  params.sid = 0;
+  esp_err_t err = esp_ble_gap_ext_adv_set_params(0, &params);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "esp_ble_gap_ext_adv_set_params failed for set 0: %d", err);
+    return false;
+  }
+  params.sid = 1;
+  err = esp_ble_gap_ext_adv_set_params(1, &params);
+  if (err != ESP_OK)
+    this->fail_("set params", 1, err);
+
+  // 之後仍會收到集 0 的完成事件，註冊後這個物件必須一直存在 (ESPHome 沒有取消註冊的 API)
+  esp32_ble::global_ble->register_gap_event_handler(this);
+  return true;
+}
+
+void ExtendedAdvertiser::gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
+  switch (event) {
+    case ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT:
+      if (param->ext_adv_set_params.status != ESP_BT_STATUS_SUCCESS)
+        this->fail_("set params", param->ext_adv_set_params.instance, param->ext_adv_set_params.status);
+      break;
+    case ESP_GAP_BLE_EXT_ADV_START_COMPLETE_EVT:
+      if (param->ext_adv_start.status != ESP_BT_STATUS_SUCCESS)
+        this->fail_("start", param->ext_adv_start.instance_num, param->ext_adv_start.status);
+      break;
+    default:
+      break;
+  }
+}
+
+void ExtendedAdvertiser::fail_(const char *operation, uint8_t set, int status) {
+  if (this->failed_.exchange(true))
+    return;
+  ESP_LOGW(TAG, "Extended advertising %s failed (set %d, status %d), HF and Deli16 now take turns on set 0",
+           operation, set, status);
+}
+
+void ExtendedAdvertiser::set_address(uint8_t set, const uint8_t *address) {
+  esp_bd_addr_t rand_addr;
+  std::copy(address, address + 6, rand_addr);
+  esp_ble_gap_ext_adv_set_rand_addr(this->set_(set), rand_addr);
+}
+
+void ExtendedAdvertiser::set_payload(uint8_t set, const AdvFrame &frame, uint8_t length) {
+  esp_ble_gap_config_ext_adv_data_raw(this->set_(set), length, frame.data());
+}
+
+void ExtendedAdvertiser::start(uint8_t set) {
+  esp_ble_gap_ext_adv_t adv = {};
+  adv.instance = this->set_(set);
+  adv.duration = 0;
+  adv.max_events = 0;
+  esp_ble_gap_ext_adv_start(1, &adv);
+}
+
+void ExtendedAdvertiser::stop(uint8_t set) {
+  // 失敗前集 1 可能已經開始廣播，失敗後第一次停止時兩個集都停止
+  if (this->failed_.load() && !this->sets_stopped_) {
+    const uint8_t sets[2] = {0, 1};
+    esp_ble_gap_ext_adv_stop(2, sets);
+    this->sets_stopped_ = true;
+    return;
+  }
+  uint8_t instance = this->set_(set);
+  esp_ble_gap_ext_adv_stop(1, &instance);
+}
+#endif
+
+#endif  // USE_ESP32
+
+}  // namespace hiflying_light
+}  // namespace esphome
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "hiflying_protocol.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#ifdef USE_HIFLYING_LIGHT_EXT_ADV
+#include "esphome/components/esp32_ble/ble.h"
+#endif
+
+namespace esphome {
+namespace hiflying_light {
+
+// 廣播間隔下限 (0.625 ms 單位)，所有廣播器共用
+static const uint16_t ADV_INTERVAL_MIN = 0x20;
+static const uint16_t ADV_INTERVAL_MAX = 0x40;
+
+// 廣播器介面: 仲裁器只透過它存取 BLE 廣播與時鐘
+// 每個廣播集 (set) 可獨立設定隨機地址與內容，傳統廣播只有一個集
+class Advertiser {
+ public:
+  virtual ~Advertiser() = default;
+
+  virtual bool setup() { return true; }
+  virtual uint8_t num_sets() const { return 1; }
+  virtual const char *get_name() const = 0;
+  virtual bool is_simulated() const { return false; }
+
+  // 仲裁器的時間來源，模擬器可以換成虛擬時鐘
+  virtual uint32_t now() const { return millis(); }
+  virtual void wait(uint32_t ms) { delay(ms); }
+  // 隨機地址與 HF 隨機字節的來源，模擬器使用固定種子讓結果可以重現
+  virtual uint32_t random() = 0;
+
+  virtual void set_address(uint8_t set, const uint8_t *address) = 0;
+  // 只使用 frame 的前 length 字節 (見 hiflying_framing.h)
+  virtual void set_payload(uint8_t set, const AdvFrame &frame, uint8_t length) = 0;
+  virtual void start(uint8_t set) = 0;
+  virtual void stop(uint8_t set) = 0;
+};
+
+// 模擬廣播器: 不使用射頻，只記錄每個地址、幀與開始/停止事件並估算空中時間
+// 主機上作為預設廣播器 (虛擬時鐘)，裝置上用於 dry_run (實際時鐘)
+enum SimEventType : uint8_t {
+  SIM_ADDRESS = 0,
+  SIM_PAYLOAD,
+  SIM_START,
+  SIM_STOP,
+};
+
+struct SimEvent {
+  uint32_t time;
+  SimEventType type;
+  uint8_t set;
+  AdvFrame data;  // SIM_ADDRESS 只使用前 6 字節
+  uint8_t length;
+};
+
+static const uint8_t SIM_LOG_SIZE = 32;
+static const uint8_t SIM_MAX_SETS = 2;
+
+class SimulatedAdvertiser : public Advertiser {
+ public:
+  explicit SimulatedAdvertiser(uint8_t num_sets = 1, bool virtual_clock = false)
+      : num_sets_(num_sets), virtual_clock_(virtual_clock) {}
+
+  uint8_t num_sets() const override { return this->num_sets_; }
+  const char *get_name() const override { return "simulated"; }
+  bool is_simulated() const override { return true; }
+
+  uint32_t now() const override { return this->virtual_clock_ ? this->clock_ : millis(); }
+  void wait(uint32_t ms) override;
+  void advance(uint32_t ms) { this->clock_ += ms; }
+  uint32_t random() override;
+
+  void set_address(uint8_t set, const uint8_t *address) override;
+  void set_payload(uint8_t set, const AdvFrame &frame, uint8_t length) override;
+  void start(uint8_t set) override;
+  void stop(uint8_t set) override;
+
+  // 最近 SIM_LOG_SIZE 個事件 (index 0 為最舊)
+  size_t event_count() const;
+  const SimEvent &event(size_t index) const;
+
+  uint32_t get_frames() const { return this->frames_; }
+  uint32_t get_address_changes() const { return this->address_changes_; }
+  // 估算的空中時間 (us): 每個廣播事件在三個頻道各發送一個 PDU
+  uint32_t get_airtime_us() const { return this->airtime_us_; }
+  uint32_t get_active_ms() const { return this->active_ms_; }
+  // 從第一次開始廣播至今的平均每秒幀數
+  float get_frames_per_second() const;
+  void reset();
+
+ protected:
+  void record_(SimEventType type, uint8_t set, const uint8_t *data, size_t length);
+
+  uint8_t num_sets_;
+  bool virtual_clock_;
+  uint32_t clock_{0};
+  uint32_t random_state_{0x2545f491};
+
+  std::array<SimEvent, SIM_LOG_SIZE> events_{};
+  uint32_t event_total_{0};
+
+  std::array<uint8_t, SIM_MAX_SETS> payload_lengths_{};
+  std::array<uint32_t, SIM_MAX_SETS> started_at_{};
+  std::array<bool, SIM_MAX_SETS> active_{};
+  uint32_t first_start_{0};
+  uint32_t frames_{0};
+  uint32_t address_changes_{0};
+  uint32_t airtime_us_{0};
+  uint32_t active_ms_{0};
+};
+
+#ifdef USE_ESP32
+// 傳統廣播 (esp_ble_gap_config_adv_data_raw)，HF 與 Deli16 需輪流使用同一個廣播
+class LegacyAdvertiser : public Advertiser {
+ public:
+  const char *get_name() const override { return "legacy"; }
+  uint32_t random() override { return random_uint32(); }
+
+  void set_address(uint8_t set, const uint8_t *address) override;
+  void set_payload(uint8_t set, const AdvFrame &frame, uint8_t length) override;
+  void start(uint8_t set) override;
+  void stop(uint8_t set) override;
+};
+
+#ifdef USE_HIFLYING_LIGHT_EXT_ADV
+// BLE 5 多集擴展廣播 (ESP32-C3/S3 等)，HF 與 Deli16 各自使用一個廣播集同時發送
+// 兩個集都使用傳統 PDU (不可連線、不可掃描)，燈具端不需要支援 BLE 5
+// 控制器以 GAP 事件非同步回報設定與開始廣播的結果，任何一個失敗後只使用集 0，HF 與 Deli16 輪流發送
+// (發出擴展廣播命令後再使用傳統廣播 API 會被控制器以 Command Disallowed 拒絕)
+class ExtendedAdvertiser : public Advertiser, public esp32_ble::GAPEventHandler {
+ public:
+  bool setup() override;
+  uint8_t num_sets() const override { return this->failed_.load() ? 1 : 2; }
+  const char *get_name() const override { return this->failed_.load() ? "extended (single set)" : "extended"; }
+  uint32_t random() override { return random_uint32(); }
+  bool has_failed() const { return this->failed_.load(); }
+
+  void set_address(uint8_t set, const uint8_t *address) override;
+  void set_payload(uint8_t set, const AdvFrame &frame, uint8_t length) override;
+  void start(uint8_t set) override;
+  void stop(uint8_t set) override;
+
+  void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) override;
+
+ protected:
+  void fail_(const char *operation, uint8_t set, int status);
+  // 失敗後所有集都對應到集 0
+  uint8_t set_(uint8_t set) const { return this->failed_.load() ? 0 : set; }
+
+  // GAP 事件可能在 BLE 任務中處理，仲裁器在自己的執行緒讀取
+  std::atomic<bool> failed_{false};
+  bool sets_stopped_{false};  // 失敗後已停止兩個擴展廣播集
+};
+#endif
+#endif
+
+}  // namespace hiflying_light
+}  // namespace esphome
@@ -0,0 +1,227 @@
+#pragma once
+
+// 批次編碼: 一次為多個命令 (場景、集線器、預編碼) 生成 HF 與 Deli16 封包
+// 輸入為 structure-of-arrays，內部以 BATCH_CHUNK 個命令為一組逐欄位處理，
+// 每個迴圈只對同一欄位做相同的運算，主機編譯器可以自動向量化
+// 與 hiflying_protocol.h 一樣只依賴標準函式庫，輸出與單一封包的 generate_*_packet() 逐字節相同
+
+#include "hiflying_protocol.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace hiflying_light {
+
+// 每個陣列各 count 項 (封包中只會出現控制器 MAC 的前 2 字節)
+struct BatchInput {
+  size_t count;
+  const uint8_t *address0;  // MAC[0]
+  const uint8_t *address1;  // MAC[1]
+  const uint16_t *counter;
+  const int8_t *ctrl_code;
+  const uint8_t *param0;
+  const uint8_t *param1;
+  const uint8_t *param2;
+  const uint8_t *random;  // HF 的隨機字節
+  uint8_t page;           // 所有命令共用
+};
+
+static const size_t BATCH_CHUNK = 16;
+static const int8_t BATCH_PAIR_CTRL_CODE = -76;
+
+// 有 SIMD 時 CRC 以逐位元運算跨命令並行 (查表無法向量化)，
+// 沒有 SIMD 的目標 (ESP32 等 Xtensa 晶片) 查表較快
+#if defined(__SSE2__) || defined(__ARM_NEON)
+static constexpr bool BATCH_BITWISE_CRC = true;
+#else
+static constexpr bool BATCH_BITWISE_CRC = false;
+#endif
+
+// Deli16 封包前 6 字節只由常數前綴 (71 0f 55 cc 55 aa) 決定
+constexpr std::array<uint8_t, 6> make_deli16_batch_head() {
+  const uint8_t prefix[6] = {0x71, 0x0f, 0x55, DELI16_CRC_PREFIX[0], DELI16_CRC_PREFIX[1], DELI16_CRC_PREFIX[2]};
+  std::array<uint8_t, 6> head{};
+  for (size_t i = 0; i < head.size(); i++)
+    head[i] = reverse_bits(prefix[i]) ^ DELI16_WHITENING_MASK[13 + i];
+  return head;
+}
+
+inline constexpr std::array<uint8_t, 6> DELI16_BATCH_HEAD = make_deli16_batch_head();
+
+namespace batch_detail {
+
+// 一組命令的輸入 (不足 BATCH_CHUNK 時以 0 補齊)，之後的迴圈次數固定，-O2 也能向量化
+struct Chunk {
+  uint8_t address0[BATCH_CHUNK];
+  uint8_t address1[BATCH_CHUNK];
+  uint8_t counter[BATCH_CHUNK];  // 封包中只使用低 8 位
+  uint8_t ctrl_code[BATCH_CHUNK];
+  uint8_t param0[BATCH_CHUNK];
+  uint8_t param1[BATCH_CHUNK];
+  uint8_t param2[BATCH_CHUNK];
+  uint8_t random[BATCH_CHUNK];
+};
+
+inline void load_chunk(const BatchInput &in, size_t base, size_t n, Chunk &chunk) {
+  for (size_t i = 0; i < BATCH_CHUNK; i++) {
+    bool valid = i < n;
+    size_t index = valid ? base + i : base;
+    chunk.address0[i] = valid ? in.address0[index] : 0;
+    chunk.address1[i] = valid ? in.address1[index] : 0;
+    chunk.counter[i] = valid ? uint8_t(in.counter[index]) : 0;
+    chunk.ctrl_code[i] = valid ? uint8_t(in.ctrl_code[index]) : 0;
+    chunk.param0[i] = valid ? in.param0[index] : 0;
+    chunk.param1[i] = valid ? in.param1[index] : 0;
+    chunk.param2[i] = valid ? in.param2[index] : 0;
+    chunk.random[i] = valid ? in.random[index] : 0;
+  }
+}
+
+// HF 內層 16 字節 (hf[k][i] 為第 i 個命令的第 k 字節)
+inline void encode_hf_chunk(const Chunk &chunk, uint8_t page, uint8_t (&hf)[16][BATCH_CHUNK]) {
+  const auto &table = ENCRYPTION_TABLE;
+  uint8_t inner_key[BATCH_CHUNK];
+  uint8_t outer_key[BATCH_CHUNK];
+
+  // apply_encryption() 的密鑰字節只取決於 data[1] (內層為計數器，外層為隨機字節)，是 16 項查表
+  for (size_t i = 0; i < BATCH_CHUNK; i++) {
+    uint8_t counter = chunk.counter[i];
+    uint8_t random = chunk.random[i];
+    inner_key[i] = table[(counter >> 4) ^ (counter & 0x0f)];
+    outer_key[i] = table[(random >> 4) ^ (random & 0x0f)];
+  }
+
+  // 內層加密作用於 [9, 14)；配對命令不加密，參數固定為 AA 66 55
+  for (size_t i = 0; i < BATCH_CHUNK; i++) {
+    uint8_t key = inner_key[i];
+    bool pair = chunk.ctrl_code[i] == uint8_t(BATCH_PAIR_CTRL_CODE);
+    hf[0][i] = 0xff;
+    hf[1][i] = chunk.random[i];
+    hf[2][i] = chunk.counter[i];
+    hf[3][i] = chunk.address0[i];
+    hf[4][i] = chunk.address1[i] & 0xf0;
+    hf[5][i] = 0;
+    hf[6][i] = 0;
+    hf[7][i] = chunk.ctrl_code[i];
+    hf[8][i] = page;
+    hf[9][i] = pair ? 0xff : uint8_t((0xff ^ key) + table[(0 + 0xaa) & 0x0f]);
+    hf[10][i] = pair ? chunk.counter[i] : uint8_t((chunk.counter[i] ^ key) + table[(1 + 0xaa) & 0x0f]);
+    hf[11][i] = pair ? 0xAA : uint8_t((chunk.param0[i] ^ key) + table[(2 + 0xaa) & 0x0f]);
+    hf[12][i] = pair ? 0x66 : uint8_t((chunk.param1[i] ^ key) + table[(3 + 0xaa) & 0x0f]);
+    hf[13][i] = pair ? 0x55 : uint8_t((chunk.param2[i] ^ key) + table[(4 + 0xaa) & 0x0f]);
+  }
+
+  // CRC-16/CCITT (初始值 0)，每個命令一個 16 位元通道
+  uint16_t crc[BATCH_CHUNK] = {};
+  for (size_t k = 0; k < 13; k++) {
+    for (size_t i = 0; i < BATCH_CHUNK; i++) {
+      if constexpr (BATCH_BITWISE_CRC) {
+        uint16_t c = crc[i] ^ uint16_t(hf[k][i] << 8);
+        for (int bit = 0; bit < 8; bit++)
+          c = uint16_t(c << 1) ^ (CRC16_POLY & uint16_t(-(c >> 15)));
+        crc[i] = c;
+      } else {
+        crc[i] = crc16_update(crc[i], hf[k][i]);
+      }
+    }
+  }
+  for (size_t i = 0; i < BATCH_CHUNK; i++) {
+    hf[14][i] = uint8_t(crc[i]);
+    hf[15][i] = uint8_t(crc[i] >> 8);
+  }
+
+  // 外層加密作用於整個 16 字節
+  for (size_t k = 0; k < 16; k++) {
+    uint8_t add = table[(k + 86) & 0x0f];
+    for (size_t i = 0; i < BATCH_CHUNK; i++)
+      hf[k][i] = uint8_t((hf[k][i] ^ outer_key[i]) + add);
+  }
+}
+
+// Deli16 的可變部分: 8 字節資料 + 2 字節 CRC (已白化)
+inline void encode_deli16_chunk(const Chunk &chunk, uint8_t page, uint8_t (&deli16)[10][BATCH_CHUNK]) {
+  uint16_t crc[BATCH_CHUNK];
+  for (size_t i = 0; i < BATCH_CHUNK; i++) {
+    uint8_t counter = chunk.counter[i];
+    uint8_t m0 = chunk.address0[i];
+    uint8_t p0 = chunk.param0[i];
+    uint8_t p2 = chunk.param2[i];
+    uint8_t temp = p2 ^ counter;
+    deli16[0][i] = temp ^ m0;
+    deli16[1][i] = temp ^ p0;
+    deli16[2][i] = page ^ temp;
+    deli16[3][i] = temp ^ chunk.param1[i];
+    deli16[4][i] = temp ^ chunk.ctrl_code[i];
+    deli16[5][i] = chunk.address1[i] ^ temp;
+    deli16[6][i] = p2 ^ m0;
+    deli16[7][i] = p0 ^ counter;
+    crc[i] = DELI16_CRC_SEED;
+  }
+
+  // 反射模式 CRC
+  for (size_t k = 0; k < 8; k++) {
+    for (size_t i = 0; i < BATCH_CHUNK; i++) {
+      if constexpr (BATCH_BITWISE_CRC) {
+        uint16_t c = crc[i] ^ deli16[k][i];
+        for (int bit = 0; bit < 8; bit++)
+          c = uint16_t(c >> 1) ^ (CRC16_POLY_REFLECTED & uint16_t(-(c & 1)));
+        crc[i] = c;
+      } else {
+        crc[i] = crc16_update_reflected(crc[i], deli16[k][i]);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < BATCH_CHUNK; i++) {
+    uint16_t final_crc = crc[i] ^ 0xffff;
+    deli16[8][i] = uint8_t(final_crc);
+    deli16[9][i] = uint8_t(final_crc >> 8);
+  }
+  for (size_t k = 0; k < 10; k++) {
+    uint8_t mask = DELI16_WHITENING_MASK[19 + k];
+    for (size_t i = 0; i < BATCH_CHUNK; i++)
+      deli16[k][i] ^= mask;
+  }
+}
+
+}  // namespace batch_detail
+
+// 為 in.count 個命令生成封包: out[0, count) 為 HF，out[count, 2 * count) 為 Deli16
+inline void encode_batch(const BatchInput &in, Packet *out) {
+  batch_detail::Chunk chunk;
+  uint8_t hf[16][BATCH_CHUNK];
+  uint8_t deli16[10][BATCH_CHUNK];
+
+  for (size_t base = 0; base < in.count; base += BATCH_CHUNK) {
+    size_t n = in.count - base < BATCH_CHUNK ? in.count - base : BATCH_CHUNK;
+    batch_detail::load_chunk(in, base, n, chunk);
+    batch_detail::encode_hf_chunk(chunk, in.page, hf);
+    batch_detail::encode_deli16_chunk(chunk, in.page, deli16);
+
+    for (size_t i = 0; i < n; i++) {
+      Packet &packet = out[base + i];
+      packet[0] = 'H';
+      packet[1] = 'F';
+      packet[2] = 'K';
+      packet[3] = 'J';
+      for (size_t k = 0; k < 16; k++)
+        packet[4 + k] = hf[k][i];
+      for (size_t k = 0; k < 6; k++)
+        packet[20 + k] = uint8_t(0x10 + k);
+    }
+    for (size_t i = 0; i < n; i++) {
+      Packet &packet = out[in.count + base + i];
+      for (size_t k = 0; k < 6; k++)
+        packet[k] = DELI16_BATCH_HEAD[k];
+      for (size_t k = 0; k < 10; k++)
+        packet[6 + k] = deli16[k][i];
+      for (size_t k = 0; k < 10; k++)
+        packet[16 + k] = uint8_t(16 + k);
+    }
+  }
+}
+
+}  // namespace hiflying_light
+}  // namespace esphome
@@ -0,0 +1,107 @@
+#pragma once
+
+// AD 資料的封裝策略: 燈具只解析 26 字節封包，不同燈具接受的外層格式不同，
+// 較短的封裝直接減少每個 PDU 的空中時間 (見 adv_pdu_airtime_us())
+// 預設的 UUID 列表一定會編譯，其餘策略只在 YAML 中有元件使用時才編譯
+
+#include "esphome/core/defines.h"
+#include "hiflying_protocol.h"
+
+#include <cstdint>
+#include <tuple>
+
+namespace esphome {
+namespace hiflying_light {
+
+static constexpr uint8_t PACKET_SIZE = std::tuple_size<Packet>::value;
+
+enum AdvFraming : uint8_t {
+  FRAMING_UUID_LIST = 0,
+  FRAMING_RAW,
+  FRAMING_MANUFACTURER,
+};
+
+// 每個策略提供相同的靜態介面: LENGTH (AD 資料總長度) 與 build() (寫入 frame 的前 LENGTH 字節)
+
+// 02 01 01 (Flags) + 1B 03 (16-bit Service UUID 列表) + 封包，與原廠遙控器相同
+struct UuidListFraming {
+  static constexpr uint8_t LENGTH = 5 + PACKET_SIZE;
+  static void build(const Packet &packet, AdvFrame &frame) { frame = build_adv_frame(packet); }
+};
+
+#ifdef USE_HIFLYING_LIGHT_FRAMING_RAW
+// 只有封包本身，不包裝成 AD 結構 (掃描端會把它當成格式錯誤的 AD 資料，只適用於直接比對原始位元組的燈具)
+struct RawFraming {
+  static constexpr uint8_t LENGTH = PACKET_SIZE;
+  static void build(const Packet &packet, AdvFrame &frame) {
+    for (size_t i = 0; i < packet.size(); i++)
+      frame[i] = packet[i];
+  }
+};
+#endif
+
+#ifdef USE_HIFLYING_LIGHT_FRAMING_MANUFACTURER
+// 1D FF (Manufacturer Specific Data) + 公司 ID + 封包，不帶 Flags
+// 0xFFFF 是 Bluetooth SIG 保留給測試用的公司 ID
+static const uint16_t MANUFACTURER_COMPANY_ID = 0xFFFF;
+
+struct ManufacturerFraming {
+  static constexpr uint8_t LENGTH = 4 + PACKET_SIZE;
+  static void build(const Packet &packet, AdvFrame &frame) {
+    frame[0] = LENGTH - 1;  // Length (類型 + 公司 ID + 封包)
+    frame[1] = 0xFF;        // AD Type: Manufacturer Specific Data
+    frame[2] = MANUFACTURER_COMPANY_ID & 0xff;
+    frame[3] = MANUFACTURER_COMPANY_ID >> 8;
+    for (size_t i = 0; i < packet.size(); i++)
+      frame[4 + i] = packet[i];
+  }
+};
+#endif
+
+// 依策略封裝封包，回傳 AD 資料長度 (frame 其餘部分不使用)
+inline uint8_t build_adv_frame(const Packet &packet, AdvFraming framing, AdvFrame &frame) {
+  switch (framing) {
+#ifdef USE_HIFLYING_LIGHT_FRAMING_RAW
+    case FRAMING_RAW:
+      RawFraming::build(packet, frame);
+      return RawFraming::LENGTH;
+#endif
+#ifdef USE_HIFLYING_LIGHT_FRAMING_MANUFACTURER
+    case FRAMING_MANUFACTURER:
+      ManufacturerFraming::build(packet, frame);
+      return ManufacturerFraming::LENGTH;
+#endif
+    default:
+      UuidListFraming::build(packet, frame);
+      return UuidListFraming::LENGTH;
+  }
+}
+
+inline uint8_t adv_frame_length(AdvFraming framing) {
+  switch (framing) {
+#ifdef USE_HIFLYING_LIGHT_FRAMING_RAW
+    case FRAMING_RAW:
+      return RawFraming::LENGTH;
+#endif
+#ifdef USE_HIFLYING_LIGHT_FRAMING_MANUFACTURER
+    case FRAMING_MANUFACTURER:
+      return ManufacturerFraming::LENGTH;
+#endif
+    default:
+      return UuidListFraming::LENGTH;
+  }
+}
+
+inline const char *framing_to_string(AdvFraming framing) {
+  switch (framing) {
+    case FRAMING_RAW:
+      return "raw";
+    case FRAMING_MANUFACTURER:
+      return "manufacturer";
+    default:
+      return "uuid_list";
+  }
+}
+
+}  // namespace hiflying_light
+}  // namespace esphome
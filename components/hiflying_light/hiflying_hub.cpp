@@ -0,0 +1,326 @@
+#include "hiflying_hub.h"
+
+#ifdef USE_HIFLYING_LIGHT_HUB
+
+#include "esphome/core/log.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/esp32_ble/ble.h"
+
+#include <algorithm>
+
+#ifdef USE_ESP32
+#include <esp_wifi.h>
+#endif
+
+namespace esphome {
+namespace hiflying_light {
+
+static const char *const TAG = "hiflying_light.hub";
+
+static const uint32_t HUB_PREF_KEY_V1 = 0x48554221;
+static const uint32_t HUB_PREF_KEY = 0x48554222;
+
+uint8_t HiFlyingLightHub::add_lamp(uint8_t instance_id, HiFlyingProtocol protocol) {
+  for (size_t i = 0; i < this->lamps_.size(); i++) {
+    if (this->lamps_[i].instance_id == instance_id)
+      return i;
+  }
+  HubLamp lamp{};
+  lamp.instance_id = instance_id;
+  lamp.protocol = protocol;
+  this->lamps_.push_back(lamp);
+  return this->lamps_.size() - 1;
+}
+
+void HiFlyingLightHub::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up HiFlying Light Hub...");
+
+  // 基礎 MAC 只查詢一次，每個燈具的 MAC 由 instance_id 推導
+#ifdef USE_ESP32
+  esp_wifi_get_mac(WIFI_IF_STA, this->base_mac_.data());
+#endif
+
+  // 所有燈具的租約結束值存在同一筆記錄中，重啟後從這裡開始即不會重用計數器
+  this->pref_ = global_preferences->make_preference<HubCounters>(HUB_PREF_KEY);
+  HubCounters saved{};
+  bool loaded = this->pref_.load(&saved);
+  if (!loaded) {
+    // 舊版記錄以 0 表示未使用 (迴繞到 0 的租約無法區分，只能從初始值開始)，下一次保存時改用新記錄
+    HubCountersV1 legacy{};
+    auto legacy_pref = global_preferences->make_preference<HubCountersV1>(HUB_PREF_KEY_V1);
+    if (legacy_pref.load(&legacy)) {
+      for (uint8_t i = 0; i < HUB_MAX_LAMPS; i++) {
+        if (legacy[i] != 0)
+          saved.set(i, legacy[i]);
+      }
+      loaded = true;
+      ESP_LOGI(TAG, "Migrated counters from the previous preference format");
+    }
+  }
+  for (auto &lamp : this->lamps_) {
+    uint8_t index = lamp.instance_id - 1;
+    lamp.counter = loaded && saved.is_valid(index) ? saved.lease_end[index] : this->initial_counter_;
+    lamp.lease_end = lamp.counter;
+  }
+  ESP_LOGD(TAG, "%s counters for %u lamps", loaded ? "Loaded" : "Initialized", unsigned(this->lamps_.size()));
+
+  auto *radio = HiFlyingRadio::get();
+  if (radio->is_dry_run())
+    ESP_LOGW(TAG, "Dry run enabled, commands will not be transmitted");
+
+#ifdef USE_ESP32
+  if (!radio->is_dry_run() && !esp32_ble::global_ble->is_active()) {
+    ESP_LOGE(TAG, "BLE not active, cannot setup HiFlying Light Hub");
+    this->mark_failed();
+  }
+#endif
+}
+
+void HiFlyingLightHub::dump_config() {
+  ESP_LOGCONFIG(TAG, "HiFlying Light Hub:");
+  ESP_LOGCONFIG(TAG, "  Lamps: %u (state table: %u bytes)", unsigned(this->lamps_.size()),
+                unsigned(this->lamps_.size() * sizeof(HubLamp)));
+  ESP_LOGCONFIG(TAG, "  Packet Interval: %d ms", this->packet_interval_);
+  ESP_LOGCONFIG(TAG, "  Packet Count: %d", this->packet_count_);
+  ESP_LOGCONFIG(TAG, "  Counter Lease: %d", this->counter_lease_);
+  ESP_LOGCONFIG(TAG, "  Framing: %s (%d bytes)", framing_to_string(this->framing_), adv_frame_length(this->framing_));
+  ESP_LOGCONFIG(TAG, "  Commands: %u (suppressed: %u)", this->commands_, this->suppressed_);
+  ESP_LOGCONFIG(TAG, "  Flash Saves: %u", this->flash_saves_);
+  ESP_LOGCONFIG(TAG, "  Base MAC: %02X:%02X:%02X:%02X:%02X:%02X", this->base_mac_[0], this->base_mac_[1],
+                this->base_mac_[2], this->base_mac_[3], this->base_mac_[4], this->base_mac_[5]);
+  for (const auto &lamp : this->lamps_) {
+    ESP_LOGCONFIG(TAG, "  Lamp %d: %s, counter %d", lamp.instance_id,
+                  lamp.protocol == PROTOCOL_HF ? "HF" : lamp.protocol == PROTOCOL_DELI16 ? "Deli16" : "HF + Deli16",
+                  lamp.counter);
+  }
+}
+
+// 串流值在本通道沒有待發送命令時才發送，發送頻率由仲裁器的輪詢決定；
+// 仲裁器的槽位只讓串流使用一半，避免大量燈具同時漸變時擠掉開關命令
+bool HiFlyingLightHub::can_stream_(const HubLamp &lamp) const {
+  auto *radio = HiFlyingRadio::get();
+  return radio->pending() < TX_POOL_SIZE / 2 && radio->pending(lamp.instance_id) == 0;
+}
+
+void HiFlyingLightHub::loop() {
+  for (auto &lamp : this->lamps_) {
+    if ((lamp.pending_brightness != 0 || lamp.pending_color_temp != 0) && this->can_stream_(lamp))
+      this->flush_stream_(lamp);
+  }
+
+  auto *radio = HiFlyingRadio::get();
+  if (!radio->uses_task())
+    radio->loop();
+}
+
+void HiFlyingLightHub::send_command(uint8_t index, HiFlyingCommand command, uint16_t param) {
+  if (index >= this->lamps_.size())
+    return;
+  HubLamp &lamp = this->lamps_[index];
+  if (this->is_cached_(lamp, command, param)) {
+    this->suppressed_++;
+    return;
+  }
+  this->queue_command_(lamp, command, param);
+}
+
+void HiFlyingLightHub::turn_off(uint8_t index) {
+  if (index >= this->lamps_.size())
+    return;
+  // 關燈後不再發送尚未送出的亮度/色溫
+  this->lamps_[index].pending_brightness = 0;
+  this->lamps_[index].pending_color_temp = 0;
+  this->send_command(index, COMMAND_OFF);
+}
+
+void HiFlyingLightHub::set_brightness(uint8_t index, uint16_t brightness) {
+  if (index >= this->lamps_.size())
+    return;
+  HubLamp &lamp = this->lamps_[index];
+  this->queue_stream_(lamp, lamp.pending_brightness, COMMAND_BRIGHTNESS, brightness);
+}
+
+void HiFlyingLightHub::set_color_temperature(uint8_t index, uint16_t color_temp) {
+  if (index >= this->lamps_.size())
+    return;
+  HubLamp &lamp = this->lamps_[index];
+  this->queue_stream_(lamp, lamp.pending_color_temp, COMMAND_COLOR_TEMP, color_temp);
+}
+
+void HiFlyingLightHub::pair(uint8_t instance_id) {
+  for (size_t i = 0; i < this->lamps_.size(); i++) {
+    if (this->lamps_[i].instance_id == instance_id) {
+      ESP_LOGI(TAG, "Pairing lamp %d", instance_id);
+      this->send_command(i, COMMAND_PAIR);
+      return;
+    }
+  }
+  ESP_LOGW(TAG, "No lamp with instance_id %d", instance_id);
+}
+
+void HiFlyingLightHub::queue_stream_(HubLamp &lamp, uint16_t &slot, HiFlyingCommand command, uint16_t value) {
+  value = std::clamp<uint16_t>(value, 1, 0x3e8);
+  if (this->is_cached_(lamp, command, value)) {
+    this->suppressed_++;
+    slot = 0;
+    return;
+  }
+  slot = value;
+  if (this->can_stream_(lamp))
+    this->flush_stream_(lamp);
+}
+
+void HiFlyingLightHub::flush_stream_(HubLamp &lamp) {
+  bool color_temp = lamp.pending_color_temp != 0 && (lamp.pending_brightness == 0 || lamp.color_temp_turn);
+  if (color_temp) {
+    this->queue_command_(lamp, COMMAND_COLOR_TEMP, lamp.pending_color_temp);
+    lamp.pending_color_temp = 0;
+  } else {
+    this->queue_command_(lamp, COMMAND_BRIGHTNESS, lamp.pending_brightness);
+    lamp.pending_brightness = 0;
+  }
+  lamp.color_temp_turn = !color_temp;
+}
+
+bool HiFlyingLightHub::queue_command_(HubLamp &lamp, HiFlyingCommand command, uint16_t param) {
+  CommandInfo info;
+  if (!HiFlyingLightComponent::get_command_info(command, info)) {
+    ESP_LOGE(TAG, "Unknown command: %d", command);
+    return false;
+  }
+
+  std::array<uint8_t, 3> params = {0, 0, 0};
+  if (command == COMMAND_BRIGHTNESS || command == COMMAND_COLOR_TEMP) {
+    param = std::clamp<uint16_t>(param, 1, 0x3e8);
+    params[1] = (param >> 8) & 0xff;
+    params[2] = param & 0xff;
+  }
+  uint8_t priority =
+      command == COMMAND_BRIGHTNESS || command == COMMAND_COLOR_TEMP ? PRIORITY_STREAM : PRIORITY_CRITICAL;
+  // 與單燈元件相同: 關燈丟棄本燈具所有尚未發送的亮度/色溫，其他命令只丟棄過期的
+  uint32_t max_age = command == COMMAND_OFF ? 0 : DEFAULT_STALE_DEADLINE;
+
+  auto device_mac = derive_device_mac(this->base_mac_.data(), lamp.instance_id);
+  std::array<uint8_t, 5> mac;
+  std::copy(device_mac.begin(), device_mac.begin() + 5, mac.begin());
+  auto protocol = static_cast<HiFlyingProtocol>(lamp.protocol);
+
+  auto *radio = HiFlyingRadio::get();
+  if (radio->uses_task()) {
+    RadioCommand cmd;
+    std::copy(mac.begin(), mac.end(), cmd.mac);
+    cmd.counter = lamp.counter;
+    cmd.ctrl_code = info.ctrl_code;
+    std::copy(params.begin(), params.end(), cmd.params);
+    cmd.lane = lamp.instance_id;
+    cmd.repeats = this->packet_count_;
+    cmd.interval = this->packet_interval_;
+    cmd.priority = priority;
+    cmd.burst = 0;
+    cmd.group = 0;
+    cmd.framing = this->framing_;
+    cmd.preempt = true;
+    cmd.max_age = max_age;
+    cmd.protocol = protocol;
+    if (!radio->submit(cmd)) {
+      ESP_LOGW(TAG, "Radio command ring full, dropping command %d for lamp %d", command, lamp.instance_id);
+      return false;
+    }
+  } else {
+    radio->preempt(lamp.instance_id, priority, max_age);
+    TxJob &job = radio->enqueue(lamp.instance_id, this->packet_count_, this->packet_interval_, priority);
+    job.protocol = protocol;
+    job.frame_length = adv_frame_length(this->framing_);
+    job.counter = lamp.counter;
+#ifdef USE_HIFLYING_LIGHT_METRICS
+    uint32_t encode_start = micros();
+#endif
+    if (protocol & PROTOCOL_HF) {
+      uint8_t random_byte = radio->get_advertiser()->random() & 0xff;
+      build_adv_frame(generate_hf_packet(mac, 3, lamp.counter, info.ctrl_code, params, random_byte), this->framing_,
+                      job.hf_frame);
+    }
+    if (protocol & PROTOCOL_DELI16)
+      build_adv_frame(generate_deli16_packet(mac, 3, lamp.counter, info.ctrl_code, params), this->framing_,
+                      job.deli16_frame);
+#ifdef USE_HIFLYING_LIGHT_METRICS
+    radio->get_encode_stats().record(micros() - encode_start, protocol == PROTOCOL_BOTH ? 2 : 1);
+#endif
+  }
+  this->commands_++;
+
+  this->advance_counter_(lamp);
+  this->update_cache_(lamp, command, param);
+  ESP_LOGD(TAG, "Lamp %d sent command %d with param %d (counter: %d)", lamp.instance_id, command, param,
+           lamp.counter - 1);
+  return true;
+}
+
+// 租約用完時寫入一次 preference，同時為已用掉一半以上租約的其他燈具延長租約，
+// 讓多個燈具共用同一次 flash 寫入
+void HiFlyingLightHub::advance_counter_(HubLamp &lamp) {
+  if (lamp.counter == lamp.lease_end) {
+    HubCounters counters{};
+    for (auto &other : this->lamps_) {
+      if (&other == &lamp || uint16_t(other.lease_end - other.counter) <= this->counter_lease_ / 2)
+        other.lease_end = other.counter + this->counter_lease_;
+      counters.set(other.instance_id - 1, other.lease_end);
+    }
+    this->pref_.save(&counters);
+    // 立即寫入 flash，與獨立元件相同: 延遲寫入前斷電會重用已發送過的計數器
+    global_preferences->sync();
+    this->flash_saves_++;
+    ESP_LOGD(TAG, "Lamp %d reserved counter lease up to %d", lamp.instance_id, lamp.lease_end);
+  }
+  lamp.counter++;
+}
+
+// 與獨立元件相同，仲裁器丟棄過本燈具尚未發送的命令時先清除快取
+bool HiFlyingLightHub::is_cached_(HubLamp &lamp, HiFlyingCommand command, uint16_t param) {
+  uint8_t lost = HiFlyingRadio::get()->get_lost(lamp.instance_id);
+  if (lost != lamp.lost_seen) {
+    lamp.lost_seen = lost;
+    this->update_cache_(lamp, COMMAND_PAIR, 0);
+  }
+  param = std::clamp<uint16_t>(param, 1, 0x3e8);
+  switch (command) {
+    case COMMAND_ON:
+    case COMMAND_OFF:
+      return lamp.power == command;
+    case COMMAND_BRIGHTNESS:
+      return lamp.power == COMMAND_ON && lamp.brightness == param;
+    case COMMAND_COLOR_TEMP:
+      return lamp.color_temp == param;
+    default:
+      return false;
+  }
+}
+
+void HiFlyingLightHub::update_cache_(HubLamp &lamp, HiFlyingCommand command, uint16_t param) {
+  param = std::clamp<uint16_t>(param, 1, 0x3e8);
+  switch (command) {
+    case COMMAND_ON:
+    case COMMAND_OFF:
+      lamp.power = command;
+      break;
+    case COMMAND_BRIGHTNESS:
+      lamp.power = COMMAND_ON;
+      lamp.brightness = param;
+      break;
+    case COMMAND_COLOR_TEMP:
+      lamp.color_temp = param;
+      break;
+    default:
+      // 配對後燈具狀態未知
+      lamp.power = 0;
+      lamp.brightness = 0;
+      lamp.color_temp = 0;
+      break;
+  }
+}
+
+}  // namespace hiflying_light
+}  // namespace esphome
+
+#endif  // USE_HIFLYING_LIGHT_HUB
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_HIFLYING_LIGHT_HUB
+
+#include "esphome/core/component.h"
+#include "esphome/core/preferences.h"
+#include "esphome/components/button/button.h"
+#include "hiflying_light.h"
+
+#include <array>
+#include <vector>
+
+namespace esphome {
+namespace hiflying_light {
+
+static const uint8_t HUB_MAX_LAMPS = 99;
+
+// 單一燈具的狀態 (18 字節)，快取與待發送值為 0 表示未知/沒有
+struct HubLamp {
+  uint16_t counter;
+  uint16_t lease_end;           // 已保存到 flash 的租約結束值
+  uint16_t brightness;          // 最後發送的亮度/色溫 (燈具刻度 1-1000)
+  uint16_t color_temp;
+  uint16_t pending_brightness;  // 串流中尚未發送的最新值
+  uint16_t pending_color_temp;
+  uint8_t instance_id;
+  uint8_t protocol;             // HiFlyingProtocol
+  uint8_t power;                // COMMAND_ON / COMMAND_OFF
+  bool color_temp_turn;         // 兩個參數都有待發送值時輪流發送
+  uint8_t lost_seen;            // 上一次看到的仲裁器遺失數 (HiFlyingRadio::get_lost)
+};
+
+// 所有燈具租約結束值的單一 preference 記錄 (以 instance_id - 1 索引)，
+// 租約結束值可能迴繞到 0，因此以 valid 位元標記已使用的項
+struct HubCounters {
+  std::array<uint16_t, HUB_MAX_LAMPS> lease_end;
+  std::array<uint8_t, (HUB_MAX_LAMPS + 7) / 8> valid;
+
+  bool is_valid(uint8_t index) const { return this->valid[index / 8] & (1 << (index % 8)); }
+  void set(uint8_t index, uint16_t value) {
+    this->lease_end[index] = value;
+    this->valid[index / 8] |= 1 << (index % 8);
+  }
+};
+
+// 舊版記錄 (0 表示未使用)，setup() 時轉換為 HubCounters
+using HubCountersV1 = std::array<uint16_t, HUB_MAX_LAMPS>;
+
+// 集線器: 以一個元件驅動多個燈具，共用基礎 MAC、編碼器與一筆計數器記錄，
+// 每個燈具只佔用狀態表中的一項，串流值在本通道沒有待發送命令時才發送
+class HiFlyingLightHub : public Component {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_BLUETOOTH; }
+
+  void set_packet_interval(uint32_t interval) { this->packet_interval_ = interval; }
+  void set_packet_count(uint8_t count) { this->packet_count_ = count; }
+  void set_counter(uint16_t counter) { this->initial_counter_ = counter; }
+  void set_counter_lease(uint16_t lease) { this->counter_lease_ = lease; }
+  void set_framing(AdvFraming framing) { this->framing_ = framing; }
+
+  // 加入一個燈具並回傳它在狀態表中的索引 (相同 instance_id 回傳既有的索引)
+  uint8_t add_lamp(uint8_t instance_id, HiFlyingProtocol protocol);
+
+  void send_command(uint8_t index, HiFlyingCommand command, uint16_t param = 0);
+  void turn_on(uint8_t index) { this->send_command(index, COMMAND_ON); }
+  void turn_off(uint8_t index);
+  void set_brightness(uint8_t index, uint16_t brightness);
+  void set_color_temperature(uint8_t index, uint16_t color_temp);
+  // 以 instance_id 配對 (供按鈕與 lambda 使用)
+  void pair(uint8_t instance_id);
+
+ protected:
+  bool queue_command_(HubLamp &lamp, HiFlyingCommand command, uint16_t param);
+  bool is_cached_(HubLamp &lamp, HiFlyingCommand command, uint16_t param);
+  void update_cache_(HubLamp &lamp, HiFlyingCommand command, uint16_t param);
+  void queue_stream_(HubLamp &lamp, uint16_t &slot, HiFlyingCommand command, uint16_t value);
+  bool can_stream_(const HubLamp &lamp) const;
+  void flush_stream_(HubLamp &lamp);
+  void advance_counter_(HubLamp &lamp);
+
+  std::vector<HubLamp> lamps_;
+  uint32_t packet_interval_{10};
+  uint8_t packet_count_{3};
+  uint16_t initial_counter_{1};
+  uint16_t counter_lease_{64};
+  AdvFraming framing_{FRAMING_UUID_LIST};
+
+  std::array<uint8_t, 6> base_mac_{};
+  ESPPreferenceObject pref_;
+  uint32_t flash_saves_{0};
+  uint32_t commands_{0};
+  uint32_t suppressed_{0};
+};
+
+class HiFlyingHubLightOutput : public HiFlyingLightOutputBase {
+ public:
+  void set_hub(HiFlyingLightHub *hub, uint8_t index) {
+    this->hub_ = hub;
+    this->index_ = index;
+  }
+  void write_state(light::LightState *state) override { this->write_values_(state); }
+
+ protected:
+  void turn_on_() override { this->hub_->turn_on(this->index_); }
+  void turn_off_() override { this->hub_->turn_off(this->index_); }
+  // 集線器不區分中間值與最終值 (沒有 adaptive_repeats)
+  void set_brightness_(uint16_t brightness, bool /*final*/) override {
+    this->hub_->set_brightness(this->index_, brightness);
+  }
+  void set_color_temperature_(uint16_t color_temp, bool /*final*/) override {
+    this->hub_->set_color_temperature(this->index_, color_temp);
+  }
+
+  HiFlyingLightHub *hub_{nullptr};
+  uint8_t index_{0};
+};
+
+class HiFlyingHubPairButton : public button::Button {
+ public:
+  void set_hub(HiFlyingLightHub *hub) { this->hub_ = hub; }
+  void set_instance_id(uint8_t instance_id) { this->instance_id_ = instance_id; }
+
+ protected:
+  void press_action() override { this->hub_->pair(this->instance_id_); }
+
+  HiFlyingLightHub *hub_{nullptr};
+  uint8_t instance_id_{1};
+};
+
+}  // namespace hiflying_light
+}  // namespace esphome
+
+#endif  // USE_HIFLYING_LIGHT_HUB
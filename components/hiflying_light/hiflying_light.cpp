@@ -1,14 +1,20 @@
 #include "hiflying_light.h"
+#ifdef USE_HIFLYING_LIGHT_SELF_TEST
+#include "hiflying_reference.h"
+#include "hiflying_batch.h"
+#endif
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/components/esp32_ble/ble.h"
 
+#include <algorithm>
+
 #ifdef USE_ESP32
 #include <esp_gap_ble_api.h>
 #include <esp_bt.h>
 #include <esp_wifi.h>
-#include <esp_random.h>
+#include <esp_attr.h>
 #endif
 
 namespace esphome {
@@ -16,6 +22,43 @@ namespace hiflying_light {
 
 static const char *const TAG = "hiflying_light";
 
+static const uint32_t PROTOCOL_PREF_KEY = 0x50524f54;
+// 探測時每個格式輪流發送 OFF/ON 的步數與間隔
+static const uint8_t PROBE_STEPS = 4;
+static const uint32_t PROBE_STEP_MS = 1500;
+// adaptive_repeats: 漸變中間值只發送一次，最終值與配對/開/關多發送一次
+static const uint8_t ADAPTIVE_STREAM_REPEATS = 1;
+static const uint8_t ADAPTIVE_EXTRA_REPEATS = 1;
+static const uint8_t MAX_REPEATS = 10;
+
+static const char *protocol_to_string(HiFlyingProtocol protocol) {
+  switch (protocol) {
+    case PROTOCOL_HF:
+      return "HF";
+    case PROTOCOL_DELI16:
+      return "Deli16";
+    case PROTOCOL_BOTH:
+      return "HF + Deli16";
+    default:
+      return "auto";
+  }
+}
+
+static uint8_t policy_index(HiFlyingCommand command) {
+  switch (command) {
+    case COMMAND_PAIR:
+      return 0;
+    case COMMAND_OFF:
+      return 1;
+    case COMMAND_ON:
+      return 2;
+    case COMMAND_BRIGHTNESS:
+      return 3;
+    default:
+      return 4;
+  }
+}
+
 // 命令映射表
 const std::map<HiFlyingCommand, CommandInfo> HiFlyingLightComponent::command_map_ = {
     {COMMAND_PAIR, {1, -76}},
@@ -25,12 +68,52 @@ const std::map<HiFlyingCommand, CommandInfo> HiFlyingLightComponent::command_map
     {COMMAND_COLOR_TEMP, {11, -73}}
 };
 
+#if defined(USE_ESP32) && defined(USE_HIFLYING_LIGHT_RTC_COUNTER)
+// RTC 記憶體中的計數器 (軟體重啟後仍保留)，以 instance_id 索引，只有設定 rtc_counter 的實例使用
+struct RtcCounter {
+  uint32_t magic;
+  uint16_t counter;
+  uint16_t lease_end;
+};
+static const uint32_t RTC_COUNTER_MAGIC = 0x484b4a00;
+static RTC_NOINIT_ATTR RtcCounter rtc_counters[100];
+#endif
+
+#ifdef USE_HIFLYING_LIGHT_SELF_TEST
+// 自我測試的隨機輸入數量 (參考實現每個封包約需數百 us，總時間控制在 setup 可接受的範圍)
+static const uint16_t SELF_TEST_VECTORS = 256;
+// 批次編碼器另外與單一封包路徑比較 (不是 BATCH_CHUNK 的倍數，覆蓋補齊的最後一組)
+static const size_t SELF_TEST_BATCH = 4 * BATCH_CHUNK + 5;
+// 所有實例共用同一套編碼器，只需測試一次，結果套用到每個實例
+static bool self_test_done = false;
+static bool self_test_passed = false;
+#endif
+
+HiFlyingLightComponent::HiFlyingLightComponent() {
+  // 配對與開關預設為高優先級，其餘沿用 packet_count / packet_interval
+  for (HiFlyingCommand command : {COMMAND_PAIR, COMMAND_OFF, COMMAND_ON})
+    this->policies_[policy_index(command)].priority = PRIORITY_CRITICAL;
+}
+
+void HiFlyingLightComponent::set_repeat_policy(HiFlyingCommand command, uint8_t repeats, uint32_t interval,
+                                               uint8_t priority) {
+  this->policies_[policy_index(command)] = {repeats, uint16_t(interval), priority};
+}
+
 void HiFlyingLightComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up HiFlying Light...");
+
+#ifdef USE_HIFLYING_LIGHT_SELF_TEST
+  if (!this->run_self_test_()) {
+    this->mark_failed();
+    return;
+  }
+#endif
   
   // 初始化 preferences 用於保存 counter (每個 instance_id 有獨立的存儲)
   uint32_t preference_hash = 0x12345678 ^ (uint32_t(this->instance_id_) << 16);
   this->pref_ = global_preferences->make_preference<uint16_t>(preference_hash);
+  // 保存的是租約結束值: 之前使用過的計數器都小於它，重啟後從這裡開始即不會重用
   uint16_t saved_counter;
   if (this->pref_.load(&saved_counter)) {
     this->counter_ = saved_counter;
@@ -39,14 +122,53 @@ void HiFlyingLightComponent::setup() {
     ESP_LOGD(TAG, "No saved counter found for instance %d, using initial value: %d", 
              this->instance_id_, this->counter_);
   }
+  // 尚未持有租約，第一次發送時才保存
+  this->lease_end_ = this->counter_;
+
+  // 探測結果與計數器分開保存，protocol: auto 時使用
+  this->protocol_pref_ = global_preferences->make_preference<uint8_t>(preference_hash ^ PROTOCOL_PREF_KEY);
+  if (this->protocol_ == PROTOCOL_AUTO) {
+    this->protocol_auto_ = true;
+    uint8_t saved_protocol;
+    if (this->protocol_pref_.load(&saved_protocol) && saved_protocol >= PROTOCOL_HF &&
+        saved_protocol <= PROTOCOL_BOTH) {
+      this->protocol_ = static_cast<HiFlyingProtocol>(saved_protocol);
+    } else {
+      ESP_LOGD(TAG, "No probed protocol for instance %d, sending both formats", this->instance_id_);
+      this->protocol_ = PROTOCOL_BOTH;
+    }
+  }
+
+#if defined(USE_ESP32) && defined(USE_HIFLYING_LIGHT_RTC_COUNTER)
+  // 軟體重啟: RTC 記憶體中的租約與 flash 一致時，直接沿用租約內的計數器
+  RtcCounter &rtc = rtc_counters[this->instance_id_];
+  if (this->rtc_counter_ && rtc.magic == (RTC_COUNTER_MAGIC | this->instance_id_) &&
+      rtc.lease_end == this->counter_ && uint16_t(rtc.lease_end - rtc.counter) <= this->counter_lease_) {
+    this->counter_ = rtc.counter;
+    ESP_LOGD(TAG, "Resumed counter from RTC memory for instance %d: %d", this->instance_id_, this->counter_);
+  }
+#endif
   
+  // dry_run: 不使用射頻，只記錄幀並估算空中時間 (所有實例共用同一個廣播器)
+  auto *radio = HiFlyingRadio::get();
+  if (radio->is_dry_run())
+    ESP_LOGW(TAG, "Dry run enabled, commands will not be transmitted");
+
   // 初始化藍芽
 #ifdef USE_ESP32
-  if (!esp32_ble::global_ble->is_active()) {
+  if (!radio->is_dry_run() && !esp32_ble::global_ble->is_active()) {
     ESP_LOGE(TAG, "BLE not active, cannot setup HiFlying Light");
     this->mark_failed();
     return;
   }
+
+  // 廣播器 (包括擴展廣播集的設定) 需在射頻任務啟動前建立，所有實例共用同一個廣播器
+  radio->get_advertiser();
+
+  if (this->radio_task_enabled_ && !radio->start_task()) {
+    ESP_LOGE(TAG, "Failed to create radio task, falling back to loop() transmission");
+    this->radio_task_enabled_ = false;
+  }
 #endif
 }
 
@@ -55,7 +177,39 @@ void HiFlyingLightComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  Instance ID: %d", this->instance_id_);
   ESP_LOGCONFIG(TAG, "  Packet Interval: %d ms", this->packet_interval_);
   ESP_LOGCONFIG(TAG, "  Packet Count: %d", this->packet_count_);
+  ESP_LOGCONFIG(TAG, "  Repeat Policy (repeats/interval ms/priority)%s:",
+                this->adaptive_repeats_ ? " with adaptive repeats" : "");
+  for (const auto &entry : command_map_) {
+    RepeatPolicy policy = this->base_policy_(entry.first);
+    ESP_LOGCONFIG(TAG, "    Command %d: %d/%d/%d", entry.first, policy.repeats, policy.interval, policy.priority);
+  }
+  ESP_LOGCONFIG(TAG, "  Blocking: %s", YESNO(this->blocking_));
+  ESP_LOGCONFIG(TAG, "  Radio Task: %s", YESNO(this->radio_task_enabled_));
+  Advertiser *advertiser = HiFlyingRadio::get()->get_advertiser();
+  ESP_LOGCONFIG(TAG, "  Advertising: %s (%d sets)", advertiser->get_name(), advertiser->num_sets());
+  ESP_LOGCONFIG(TAG, "  Protocol: %s%s", protocol_to_string(this->protocol_),
+                this->protocol_auto_ ? " (auto)" : "");
+  ESP_LOGCONFIG(TAG, "  Framing: %s (%d bytes)", framing_to_string(this->framing_), adv_frame_length(this->framing_));
   ESP_LOGCONFIG(TAG, "  Counter: %d", this->counter_);
+  ESP_LOGCONFIG(TAG, "  Counter Lease: %d%s", this->counter_lease_, this->rtc_counter_ ? " (RTC memory)" : "");
+  ESP_LOGCONFIG(TAG, "  Preemption: %s (stale after %u ms)", YESNO(this->preemption_), this->stale_deadline_);
+  ESP_LOGCONFIG(TAG, "  Commands: %u (coalesced: %u, suppressed: %u, dropped: %u, preempted: %u)", this->commands_,
+                this->coalesced_, this->suppressed_, HiFlyingRadio::get()->get_dropped(),
+                HiFlyingRadio::get()->get_preempted());
+  ESP_LOGCONFIG(TAG, "  Flash Saves: %u", this->flash_saves_);
+  if (this->pre_encode_ != PRE_ENCODE_NONE)
+    ESP_LOGCONFIG(TAG, "  Pre-encoded Hits: %u", this->pre_encoded_hits_);
+#ifdef USE_HIFLYING_LIGHT_METRICS
+  const EncodeStats &stats = HiFlyingRadio::get()->get_encode_stats();
+  if (stats.frames > 0) {
+    ESP_LOGCONFIG(TAG, "  Encode Time: %u us mean, %u us max per frame (%u frames)", stats.total_us / stats.frames,
+                  stats.max_us, stats.frames);
+    ESP_LOGCONFIG(TAG, "  Encode Histogram (<16/32/64/128/256/512/1024/more us): %u %u %u %u %u %u %u %u",
+                  stats.histogram[0], stats.histogram[1], stats.histogram[2], stats.histogram[3], stats.histogram[4],
+                  stats.histogram[5], stats.histogram[6], stats.histogram[7]);
+  }
+  ESP_LOGCONFIG(TAG, "  Blocked Time: %u us total", this->blocked_us_total_);
+#endif
   
   auto mac = this->get_device_mac();
   ESP_LOGCONFIG(TAG, "  Device MAC: %02X:%02X:%02X:%02X:%02X:%02X",
@@ -63,29 +217,221 @@ void HiFlyingLightComponent::dump_config() {
 }
 
 std::array<uint8_t, 6> HiFlyingLightComponent::get_device_mac() {
-  uint8_t base_mac[6];
+  uint8_t base_mac[6] = {0};
 #ifdef USE_ESP32
   esp_wifi_get_mac(WIFI_IF_STA, base_mac);
 #endif
-  
-  std::array<uint8_t, 6> device_mac;
-  // 使用 ESP32 MAC 的前 4 字節
-  device_mac[0] = base_mac[0];
-  device_mac[1] = base_mac[1]; 
-  device_mac[2] = base_mac[2];
-  device_mac[3] = base_mac[3];
-  // 最後兩字節用 instance_id 計算
-  device_mac[4] = base_mac[4];
-  device_mac[5] = base_mac[5] + this->instance_id_ - 1;
-  
-  return device_mac;
+  return derive_device_mac(base_mac, this->instance_id_);
+}
+
+Packet HiFlyingLightComponent::generate_hf_packet_(const std::array<uint8_t, 5> &mac, uint8_t page, uint16_t counter,
+                                                  int8_t ctrl_code, const std::array<uint8_t, 3> &params) {
+  return generate_hf_packet(mac, page, counter, ctrl_code, params,
+                            HiFlyingRadio::get()->get_advertiser()->random() & 0xff);
 }
 
+Packet HiFlyingLightComponent::generate_deli16_packet_(const std::array<uint8_t, 5> &mac, uint8_t page,
+                                                      uint16_t counter, int8_t ctrl_code,
+                                                      const std::array<uint8_t, 3> &params) {
+  return generate_deli16_packet(mac, page, counter, ctrl_code, params);
+}
+
+#ifdef USE_HIFLYING_LIGHT_SELF_TEST
+// 差分自我測試: 以隨機輸入比較優化編碼器與參考實現 (hiflying_reference.h) 的輸出，
+// 任何一個位元組不同即表示優化引入了回歸，燈具將無法解碼，因此直接標記失敗
+bool HiFlyingLightComponent::run_self_test_() {
+  if (self_test_done)
+    return self_test_passed;
+  self_test_done = true;
+
+  uint32_t optimized_us = 0;
+  uint32_t reference_us = 0;
+  for (uint16_t i = 0; i < SELF_TEST_VECTORS; i++) {
+    uint32_t r0 = random_uint32();
+    uint32_t r1 = random_uint32();
+    uint32_t r2 = random_uint32();
+    std::array<uint8_t, 5> mac = {uint8_t(r0), uint8_t(r0 >> 8), uint8_t(r0 >> 16), uint8_t(r0 >> 24), uint8_t(r1)};
+    uint16_t counter = r1 >> 8;
+    int8_t ctrl_code = int8_t(r1 >> 24);
+    // 大部分向量使用固定的 page 3，其餘覆蓋任意值
+    uint8_t page = (r2 & 0x03) == 0 ? uint8_t(r2 >> 2) : 3;
+    std::array<uint8_t, 3> params = {uint8_t(r2 >> 8), uint8_t(r2 >> 16), uint8_t(r2 >> 24)};
+    uint8_t random_byte = random_uint32() & 0xff;
+    // 配對命令走不同的分支，確保每次測試都有覆蓋
+    if (i % 16 == 0)
+      ctrl_code = -76;
+
+    uint32_t start = micros();
+    Packet hf = generate_hf_packet(mac, page, counter, ctrl_code, params, random_byte);
+    Packet deli16 = generate_deli16_packet(mac, page, counter, ctrl_code, params);
+    uint32_t mid = micros();
+    std::vector<uint8_t> ref_hf = reference::generate_hf_packet(mac, page, counter, ctrl_code, params, random_byte);
+    std::vector<uint8_t> ref_deli16 = reference::generate_deli16_packet(mac, page, counter, ctrl_code, params);
+    uint32_t end = micros();
+    optimized_us += mid - start;
+    reference_us += end - mid;
+
+    bool hf_ok = std::equal(hf.begin(), hf.end(), ref_hf.begin());
+    if (!hf_ok || !std::equal(deli16.begin(), deli16.end(), ref_deli16.begin())) {
+      ESP_LOGE(TAG, "Self test failed: %s packet differs from reference (counter %u, ctrl %d, page %u)",
+               hf_ok ? "Deli16" : "HF", counter, ctrl_code, page);
+      ESP_LOGE(TAG, "  Optimized: %s", format_hex_pretty(hf_ok ? deli16.data() : hf.data(), hf.size()).c_str());
+      ESP_LOGE(TAG, "  Reference: %s", format_hex_pretty(hf_ok ? ref_deli16.data() : ref_hf.data(), hf.size()).c_str());
+      return false;
+    }
+  }
+
+  uint32_t batch_us = 0;
+  uint32_t single_us = 0;
+  if (!this->run_batch_self_test_(batch_us, single_us))
+    return false;
+
+  uint32_t packets = uint32_t(SELF_TEST_VECTORS) * 2;
+  ESP_LOGI(TAG, "Self test passed: %u packets identical to reference", packets);
+  ESP_LOGI(TAG, "  Optimized: %u us total, %.2f us/packet", optimized_us, float(optimized_us) / packets);
+  ESP_LOGI(TAG, "  Reference: %u us total, %.2f us/packet", reference_us, float(reference_us) / packets);
+  ESP_LOGI(TAG, "  Batch: %u us for %u packets (single-frame path: %u us)", batch_us,
+           unsigned(SELF_TEST_BATCH * 2), single_us);
+  self_test_passed = true;
+  return true;
+}
+
+// 批次編碼器 (hiflying_batch.h) 必須與單一封包路徑逐字節相同，同時比較兩者在本晶片上的速度
+bool HiFlyingLightComponent::run_batch_self_test_(uint32_t &batch_us, uint32_t &single_us) {
+  std::vector<uint8_t> address0(SELF_TEST_BATCH), address1(SELF_TEST_BATCH), param0(SELF_TEST_BATCH),
+      param1(SELF_TEST_BATCH), param2(SELF_TEST_BATCH), random_bytes(SELF_TEST_BATCH);
+  std::vector<uint16_t> counters(SELF_TEST_BATCH);
+  std::vector<int8_t> ctrl_codes(SELF_TEST_BATCH);
+  for (size_t i = 0; i < SELF_TEST_BATCH; i++) {
+    uint32_t r0 = random_uint32();
+    uint32_t r1 = random_uint32();
+    address0[i] = r0;
+    address1[i] = r0 >> 8;
+    counters[i] = r0 >> 16;
+    ctrl_codes[i] = i % 16 == 0 ? -76 : int8_t(r1);
+    param0[i] = r1 >> 8;
+    param1[i] = r1 >> 16;
+    param2[i] = r1 >> 24;
+    random_bytes[i] = random_uint32() & 0xff;
+  }
+  BatchInput input{SELF_TEST_BATCH, address0.data(), address1.data(), counters.data(), ctrl_codes.data(),
+                   param0.data(),   param1.data(),   param2.data(),   random_bytes.data(), 3};
+
+  std::vector<Packet> batch(2 * SELF_TEST_BATCH);
+  std::vector<Packet> single(2 * SELF_TEST_BATCH);
+  uint32_t start = micros();
+  encode_batch(input, batch.data());
+  uint32_t mid = micros();
+  for (size_t i = 0; i < SELF_TEST_BATCH; i++) {
+    std::array<uint8_t, 5> mac = {address0[i], address1[i], 0, 0, 0};
+    std::array<uint8_t, 3> params = {param0[i], param1[i], param2[i]};
+    single[i] = generate_hf_packet(mac, 3, counters[i], ctrl_codes[i], params, random_bytes[i]);
+    single[SELF_TEST_BATCH + i] = generate_deli16_packet(mac, 3, counters[i], ctrl_codes[i], params);
+  }
+  uint32_t end = micros();
+
+  for (size_t i = 0; i < batch.size(); i++) {
+    if (batch[i] != single[i]) {
+      ESP_LOGE(TAG, "Self test failed: batch %s packet %u differs (counter %u, ctrl %d)",
+               i < SELF_TEST_BATCH ? "HF" : "Deli16", unsigned(i % SELF_TEST_BATCH),
+               counters[i % SELF_TEST_BATCH], ctrl_codes[i % SELF_TEST_BATCH]);
+      ESP_LOGE(TAG, "  Batch:  %s", format_hex_pretty(batch[i].data(), batch[i].size()).c_str());
+      ESP_LOGE(TAG, "  Single: %s", format_hex_pretty(single[i].data(), single[i].size()).c_str());
+      return false;
+    }
+  }
+
+  batch_us = mid - start;
+  single_us = end - mid;
+  return true;
+}
+#endif
+
 void HiFlyingLightComponent::send_command(HiFlyingCommand command, uint16_t param) {
+  if (this->is_cached_(command, param)) {
+    this->suppressed_++;
+    ESP_LOGV(TAG, "Instance %d lamp already has command %d param %d, not sending", this->instance_id_, command, param);
+    return;
+  }
+
+#ifdef USE_HIFLYING_LIGHT_METRICS
+  uint32_t start = micros();
+#endif
+  if (this->queue_command_(command, param, 0) && this->blocking_) {
+    // blocking 模式: 立即阻塞直到發送完成
+    HiFlyingRadio::get()->flush();
+  }
+#ifdef USE_HIFLYING_LIGHT_METRICS
+  this->add_blocked_(start);
+#endif
+}
+
+#ifdef USE_HIFLYING_LIGHT_METRICS
+// 記錄從 start 起佔用 ESPHome loop 的時間 (write_state 與 loop() 中的編碼、入隊及 blocking 等待)
+void HiFlyingLightComponent::add_blocked_(uint32_t start) {
+  uint32_t blocked = micros() - start;
+  this->blocked_us_total_ += blocked;
+  if (blocked > this->blocked_us_max_)
+    this->blocked_us_max_ = blocked;
+}
+#endif
+
+uint32_t HiFlyingLightComponent::take_blocked_us_max() {
+  uint32_t blocked = this->blocked_us_max_;
+  this->blocked_us_max_ = 0;
+  return blocked;
+}
+
+// 場景: 先為所有燈具編碼並入隊，再一起交給仲裁器以交錯方式發送，
+// 仲裁器輪詢一圈即可讓每個燈具收到第一份封包
+void HiFlyingLightComponent::send_scene(const std::vector<SceneEntry> &entries) {
+  auto *radio = HiFlyingRadio::get();
+  uint8_t burst = radio->begin_burst(entries.size());
+  bool blocking = false;
+
+  for (const auto &entry : entries) {
+    if (!entry.light->queue_command_(entry.command, entry.param, burst))
+      radio->cancel_burst_entry(burst);
+    blocking |= entry.light->blocking_;
+  }
+
+  if (blocking)
+    radio->flush();
+}
+
+// 策略表中的設定 (未設定的欄位沿用 packet_count / packet_interval)
+RepeatPolicy HiFlyingLightComponent::base_policy_(HiFlyingCommand command) const {
+  RepeatPolicy policy = this->policies_[policy_index(command)];
+  if (policy.repeats == 0)
+    policy.repeats = this->packet_count_;
+  if (policy.interval == 0)
+    policy.interval = this->packet_interval_;
+  return policy;
+}
+
+// 實際發送使用的策略 (adaptive_repeats 時依命令是否為漸變中間值調整重複次數)
+RepeatPolicy HiFlyingLightComponent::policy_for_(HiFlyingCommand command, bool intermediate) const {
+  RepeatPolicy policy = this->base_policy_(command);
+  if (!this->adaptive_repeats_)
+    return policy;
+
+  // 漸變的中間值很快就會被取代，掉了也無妨；最終值 (前面有減少重複的中間值時) 與關鍵命令必須送達
+  bool reduced_stream = (command == COMMAND_BRIGHTNESS && this->brightness_slot_.reduced) ||
+                        (command == COMMAND_COLOR_TEMP && this->color_temp_slot_.reduced);
+  if (intermediate) {
+    policy.repeats = ADAPTIVE_STREAM_REPEATS;
+  } else if (reduced_stream || policy.priority >= PRIORITY_CRITICAL) {
+    policy.repeats = std::min<uint8_t>(policy.repeats + ADAPTIVE_EXTRA_REPEATS, MAX_REPEATS);
+  }
+  return policy;
+}
+
+bool HiFlyingLightComponent::queue_command_(HiFlyingCommand command, uint16_t param, uint8_t burst,
+                                            bool intermediate, uint8_t group) {
   auto it = command_map_.find(command);
   if (it == command_map_.end()) {
     ESP_LOGE(TAG, "Unknown command: %d", command);
-    return;
+    return false;
   }
 
   const CommandInfo &cmd_info = it->second;
@@ -99,24 +445,228 @@ void HiFlyingLightComponent::send_command(HiFlyingCommand command, uint16_t para
     params[2] = param & 0xff;
   }
 
-  // 獲取設備 MAC (只取前 5 字節給協議使用)
+  // 探測期間只發送正在測試的格式
+  HiFlyingProtocol protocol = this->probe_protocol_ != PROTOCOL_AUTO ? this->probe_protocol_ : this->protocol_;
+  RepeatPolicy policy = this->policy_for_(command, intermediate);
+  // 關燈後才送出的亮度/色溫會重新點亮燈具，因此關燈丟棄本通道所有尚未發送的低優先級命令
+  uint32_t max_age = command == COMMAND_OFF ? 0 : this->stale_deadline_;
+
+  auto *radio = HiFlyingRadio::get();
+  if (radio->uses_task()) {
+    // 只推入命令記錄，編碼與廣播交由射頻任務處理
+    RadioCommand cmd;
+    auto mac_5 = this->get_mac_5_();
+    std::copy(mac_5.begin(), mac_5.end(), cmd.mac);
+    cmd.counter = this->counter_;
+    cmd.ctrl_code = cmd_info.ctrl_code;
+    std::copy(params.begin(), params.end(), cmd.params);
+    cmd.lane = this->instance_id_;
+    cmd.repeats = policy.repeats;
+    cmd.interval = policy.interval;
+    cmd.priority = policy.priority;
+    cmd.burst = burst;
+    cmd.group = group;
+    cmd.protocol = protocol;
+    cmd.framing = this->framing_;
+    cmd.preempt = this->preemption_;
+    cmd.max_age = std::min<uint32_t>(max_age, UINT16_MAX);
+    if (!radio->submit(cmd)) {
+      ESP_LOGW(TAG, "Radio command ring full, dropping command %d", command);
+      return false;
+    }
+  } else {
+    // 直接在仲裁器的槽位中生成 AD 幀，不經過任何暫存緩衝
+    if (this->preemption_)
+      radio->preempt(this->instance_id_, policy.priority, max_age, group);
+    TxJob &job = radio->enqueue(this->instance_id_, policy.repeats, policy.interval, policy.priority, group);
+    job.burst = burst;
+    job.protocol = protocol;
+    job.frame_length = adv_frame_length(this->framing_);
+    job.counter = this->counter_;
+    // 閒置時已為這個計數器預先編碼時直接複製，否則現在編碼
+    if (!this->take_pre_encoded_(command, param, protocol, job)) {
+#ifdef USE_HIFLYING_LIGHT_METRICS
+      uint32_t encode_start = micros();
+#endif
+      this->encode_frames_(cmd_info, params, this->counter_, protocol, job.hf_frame, job.deli16_frame);
+#ifdef USE_HIFLYING_LIGHT_METRICS
+      radio->get_encode_stats().record(micros() - encode_start, protocol == PROTOCOL_BOTH ? 2 : 1);
+#endif
+    }
+  }
+  this->commands_++;
+
+  // 遞增計數器 (只在租約用完時寫入 flash)
+  this->advance_counter_();
+  this->update_cache(command, param);
+  if (command == COMMAND_BRIGHTNESS)
+    this->brightness_slot_.reduced = intermediate;
+  else if (command == COMMAND_COLOR_TEMP)
+    this->color_temp_slot_.reduced = intermediate;
+
+  ESP_LOGD(TAG, "Instance %d sent command %d with param %d (counter: %d, repeats: %d)", this->instance_id_, command,
+           param, this->counter_ - 1, policy.repeats);
+  return true;
+}
+
+// 獲取設備 MAC (只取前 5 字節給協議使用)
+std::array<uint8_t, 5> HiFlyingLightComponent::get_mac_5_() {
   auto device_mac = this->get_device_mac();
   std::array<uint8_t, 5> mac_5;
   std::copy(device_mac.begin(), device_mac.begin() + 5, mac_5.begin());
+  return mac_5;
+}
+
+void HiFlyingLightComponent::encode_frames_(const CommandInfo &cmd_info, const std::array<uint8_t, 3> &params,
+                                            uint16_t counter, HiFlyingProtocol protocol, AdvFrame &hf_frame,
+                                            AdvFrame &deli16_frame) {
+  auto mac_5 = this->get_mac_5_();
+  if (protocol & PROTOCOL_HF)
+    build_adv_frame(this->generate_hf_packet_(mac_5, 3, counter, cmd_info.ctrl_code, params), this->framing_,
+                    hf_frame);
+  if (protocol & PROTOCOL_DELI16)
+    build_adv_frame(this->generate_deli16_packet_(mac_5, 3, counter, cmd_info.ctrl_code, params), this->framing_,
+                    deli16_frame);
+}
+
+// 預編碼: 每次 loop() 最多更新一個過期的槽位 (計數器、格式或亮度已改變)
+// HF 的隨機字節在預編碼時就抽取，每個計數器只會使用一次
+void HiFlyingLightComponent::pre_encode_loop_(HiFlyingProtocol protocol) {
+  static const HiFlyingCommand SLOT_COMMANDS[3] = {COMMAND_ON, COMMAND_OFF, COMMAND_BRIGHTNESS};
+  uint8_t slots = this->pre_encode_ == PRE_ENCODE_LAST_BRIGHTNESS ? 3 : 2;
+
+  for (uint8_t i = 0; i < slots; i++) {
+    HiFlyingCommand command = SLOT_COMMANDS[i];
+    uint16_t param = command == COMMAND_BRIGHTNESS ? this->cached_brightness_ : 0;
+    if (command == COMMAND_BRIGHTNESS && param == 0)
+      continue;
+
+    PreEncodedFrames &slot = this->pre_encoded_[i];
+    if (slot.protocol == protocol && slot.counter == this->counter_ && slot.param == param)
+      continue;
+
+    std::array<uint8_t, 3> params = {0, uint8_t(param >> 8), uint8_t(param & 0xff)};
+    this->encode_frames_(command_map_.at(command), params, this->counter_, protocol, slot.hf_frame,
+                         slot.deli16_frame);
+    slot.counter = this->counter_;
+    slot.param = param;
+    slot.protocol = protocol;
+    return;
+  }
+}
 
-  // 生成封包
-  auto hf_packet = this->generate_hf_packet_(mac_5, 3, this->counter_, cmd_info.ctrl_code, params);
-  auto deli16_packet = this->generate_deli16_packet_(mac_5, 3, this->counter_, cmd_info.ctrl_code, params);
+bool HiFlyingLightComponent::take_pre_encoded_(HiFlyingCommand command, uint16_t param, HiFlyingProtocol protocol,
+                                               TxJob &job) {
+  if (this->pre_encode_ == PRE_ENCODE_NONE)
+    return false;
+
+  int index;
+  switch (command) {
+    case COMMAND_ON:
+      index = 0;
+      break;
+    case COMMAND_OFF:
+      index = 1;
+      break;
+    case COMMAND_BRIGHTNESS:
+      index = 2;
+      break;
+    default:
+      return false;
+  }
 
-  // 發送封包
-  this->send_packets_(hf_packet, deli16_packet);
+  PreEncodedFrames &slot = this->pre_encoded_[index];
+  if (slot.protocol != protocol || slot.counter != this->counter_ || (index == 2 && slot.param != param))
+    return false;
 
-  // 遞增計數器並保存
+  job.hf_frame = slot.hf_frame;
+  job.deli16_frame = slot.deli16_frame;
+  // 使用後失效，避免同一計數器的隨機字節被重複使用
+  slot.protocol = PROTOCOL_AUTO;
+  this->pre_encoded_hits_++;
+  return true;
+}
+
+// 亮度/色溫以燈具刻度比較，超出範圍的值與 queue_command_() 一樣先限制在 1-1000
+// 仲裁器丟棄過本通道尚未發送的命令時，快取可能記錄了燈具從未收到的值，先清除再比較
+bool HiFlyingLightComponent::is_cached_(HiFlyingCommand command, uint16_t param) {
+  uint8_t lost = HiFlyingRadio::get()->get_lost(this->instance_id_);
+  if (lost != this->lost_seen_) {
+    this->lost_seen_ = lost;
+    this->invalidate_cache();
+  }
+  param = std::clamp<uint16_t>(param, 1, 0x3e8);
+  switch (command) {
+    case COMMAND_ON:
+    case COMMAND_OFF:
+      return this->cached_power_ == command;
+    case COMMAND_BRIGHTNESS:
+      return this->cached_power_ == COMMAND_ON && this->cached_brightness_ == param;
+    case COMMAND_COLOR_TEMP:
+      return this->cached_color_temp_ == param;
+    default:
+      return false;
+  }
+}
+
+void HiFlyingLightComponent::update_cache(HiFlyingCommand command, uint16_t param) {
+  param = std::clamp<uint16_t>(param, 1, 0x3e8);
+  switch (command) {
+    case COMMAND_ON:
+    case COMMAND_OFF:
+      this->cached_power_ = command;
+      break;
+    case COMMAND_BRIGHTNESS:
+      // 燈具收到亮度命令時會開燈
+      this->cached_power_ = COMMAND_ON;
+      this->cached_brightness_ = param;
+      break;
+    case COMMAND_COLOR_TEMP:
+      this->cached_color_temp_ = param;
+      break;
+    default:
+      // 配對後燈具狀態未知
+      this->invalidate_cache();
+      break;
+  }
+}
+
+bool HiFlyingLightComponent::command_from_ctrl_code(int8_t ctrl_code, HiFlyingCommand &command) {
+  for (const auto &entry : command_map_) {
+    if (entry.second.ctrl_code == ctrl_code) {
+      command = entry.first;
+      return true;
+    }
+  }
+  return false;
+}
+
+void HiFlyingLightComponent::invalidate_cache() {
+  this->cached_power_ = 0;
+  this->cached_brightness_ = 0;
+  this->cached_color_temp_ = 0;
+}
+
+// 計數器租約: 一次保存預留 counter_lease_ 個值，期間只在 RAM 中遞增
+void HiFlyingLightComponent::advance_counter_() {
+  if (this->counter_ == this->lease_end_) {
+    this->lease_end_ = this->counter_ + this->counter_lease_;
+    this->pref_.save(&this->lease_end_);
+    // 立即寫入 flash: 租約在 preferences 延遲寫入前斷電時會重用已發送過的計數器
+    global_preferences->sync();
+    this->flash_saves_++;
+    ESP_LOGD(TAG, "Instance %d reserved counter lease up to %d", this->instance_id_, this->lease_end_);
+  }
   this->counter_++;
-  this->pref_.save(&this->counter_);
 
-  ESP_LOGD(TAG, "Instance %d sent command %d with param %d (counter: %d)", 
-            this->instance_id_, command, param, this->counter_ - 1);
+#if defined(USE_ESP32) && defined(USE_HIFLYING_LIGHT_RTC_COUNTER)
+  if (!this->rtc_counter_)
+    return;
+  RtcCounter &rtc = rtc_counters[this->instance_id_];
+  rtc.magic = RTC_COUNTER_MAGIC | this->instance_id_;
+  rtc.counter = this->counter_;
+  rtc.lease_end = this->lease_end_;
+#endif
 }
 
 void HiFlyingLightComponent::pair() {
@@ -128,380 +678,227 @@ void HiFlyingLightComponent::turn_on() {
 }
 
 void HiFlyingLightComponent::turn_off() {
+  // 關燈後不再發送尚未送出的亮度/色溫，避免燈具被重新點亮
+  this->brightness_slot_ = {};
+  this->color_temp_slot_ = {};
   this->send_command(COMMAND_OFF);
 }
 
-void HiFlyingLightComponent::set_brightness(uint16_t brightness) {
-  this->send_command(COMMAND_BRIGHTNESS, brightness);
+void HiFlyingLightComponent::set_brightness(uint16_t brightness, bool final) {
+  this->queue_stream_(this->brightness_slot_, COMMAND_BRIGHTNESS, brightness, final);
 }
 
-void HiFlyingLightComponent::set_color_temperature(uint16_t color_temp) {
-  this->send_command(COMMAND_COLOR_TEMP, color_temp);
+void HiFlyingLightComponent::set_color_temperature(uint16_t color_temp, bool final) {
+  this->queue_stream_(this->color_temp_slot_, COMMAND_COLOR_TEMP, color_temp, final);
 }
 
-// TEA 加密實現
-std::array<uint8_t, 8> HiFlyingLightComponent::tea_encrypt_(const std::array<uint8_t, 8> &data) {
-  const char key[] = "!hIflIngCypcal@#";
-  
-  uint32_t v0 = (data[0]) | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
-  uint32_t v1 = (data[4]) | (data[5] << 8) | (data[6] << 16) | (data[7] << 24);
-  
-  uint32_t k0 = (key[0]) | (key[1] << 8) | (key[2] << 16) | (key[3] << 24);
-  uint32_t k1 = (key[4]) | (key[5] << 8) | (key[6] << 16) | (key[7] << 24);
-  uint32_t k2 = (key[8]) | (key[9] << 8) | (key[10] << 16) | (key[11] << 24);
-  uint32_t k3 = (key[12]) | (key[13] << 8) | (key[14] << 16) | (key[15] << 24);
-  
-  uint32_t delta = 0x9e3779b9;
-  uint32_t sum_val = 0xc6ef3720;
-  
-  for (int i = 0; i < 32; i++) {
-    v1 = (v1 - (((v0 << 4) + k2) ^ (v0 + sum_val) ^ ((v0 >> 5) + k3))) & 0xffffffff;
-    v0 = (v0 - (((v1 << 4) + k0) ^ (v1 + sum_val) ^ ((v1 >> 5) + k1))) & 0xffffffff;
-    sum_val = (sum_val - delta) & 0xffffffff;
+// 複合命令: 開燈時連同亮度/色溫 (或漸變結束時的多個最終值) 以連續的計數器一次編碼入隊，
+// 仲裁器在同一個突發中交錯它們的重複，第一輪就送出每個命令的第一份封包
+void HiFlyingLightComponent::send_compound(bool turn_on, uint16_t brightness, uint16_t color_temp, bool final) {
+  // 燈具已開時的漸變中間值交給串流合併，避免每一步都佔用一個完整突發
+  if (!this->compound_commands_ || (!turn_on && !final)) {
+    if (turn_on)
+      this->turn_on();
+    if (brightness != 0)
+      this->set_brightness(brightness, final);
+    if (color_temp != 0)
+      this->set_color_temperature(color_temp, final);
+    return;
   }
-  
-  std::array<uint8_t, 8> result;
-  result[0] = v0 & 0xff;
-  result[1] = (v0 >> 8) & 0xff;
-  result[2] = (v0 >> 16) & 0xff;
-  result[3] = (v0 >> 24) & 0xff;
-  result[4] = v1 & 0xff;
-  result[5] = (v1 >> 8) & 0xff;
-  result[6] = (v1 >> 16) & 0xff;
-  result[7] = (v1 >> 24) & 0xff;
-  
-  return result;
-}
 
-// 獲取加密表
-std::array<uint8_t, 16> HiFlyingLightComponent::get_encryption_table_() {
-  const std::array<uint8_t, 16> base_key = {
-    0x52, 0xea, 0x73, 0xff, 0x49, 0x60, 0xbf, 0x56,
-    0x42, 0x05, 0x07, 0xe8, 0xd3, 0xa7, 0xb9, 0x9d
-  };
-  
-  std::array<uint8_t, 16> table;
-  
-  std::array<uint8_t, 8> part1;
-  std::copy(base_key.begin(), base_key.begin() + 8, part1.begin());
-  auto encrypted1 = this->tea_encrypt_(part1);
-  std::copy(encrypted1.begin(), encrypted1.end(), table.begin());
-  
-  std::array<uint8_t, 8> part2;
-  std::copy(base_key.begin() + 8, base_key.end(), part2.begin());
-  auto encrypted2 = this->tea_encrypt_(part2);
-  std::copy(encrypted2.begin(), encrypted2.end(), table.begin() + 8);
-  
-  return table;
-}
-
-// 應用加密
-void HiFlyingLightComponent::apply_encryption_(std::vector<uint8_t> &data, size_t start, size_t length, uint8_t key) {
-  auto enc_table = this->get_encryption_table_();
-  
-  if (start + 1 < data.size()) {
-    uint8_t b = data[start + 1];
-    uint8_t i = b & 0x0f;
-    b = enc_table[((b >> 4) & 0x0f) ^ i];
-    
-    for (size_t j = 0; j < length; j++) {
-      if (start + j < data.size()) {
-        size_t pos = start + j;
-        uint8_t i2 = data[pos] ^ b;
-        uint8_t i3 = (j + key) & 0x0f;
-        data[pos] = ((i2 & 0xff) + enc_table[i3 & 0xff]) & 0xff;
-      }
+  struct {
+    HiFlyingCommand command;
+    uint16_t param;
+  } commands[3];
+  uint8_t count = 0;
+  if (turn_on)
+    commands[count++] = {COMMAND_ON, 0};
+  if (brightness != 0)
+    commands[count++] = {COMMAND_BRIGHTNESS, std::clamp<uint16_t>(brightness, 1, 0x3e8)};
+  if (color_temp != 0)
+    commands[count++] = {COMMAND_COLOR_TEMP, std::clamp<uint16_t>(color_temp, 1, 0x3e8)};
+
+  // 新值取代串流中尚未發送的舊值
+  if (brightness != 0)
+    this->brightness_slot_.value = 0;
+  if (color_temp != 0)
+    this->color_temp_slot_.value = 0;
+
+  // 開燈尚未寫入快取，這裡的比較與逐一發送時相同
+  uint8_t kept = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (this->is_cached_(commands[i].command, commands[i].param)) {
+      this->suppressed_++;
+      continue;
     }
+    commands[kept++] = commands[i];
+  }
+  if (kept == 0)
+    return;
+  if (kept == 1) {
+    this->send_command(commands[0].command, commands[0].param);
+    return;
   }
-}
 
-// CRC16 計算
-uint16_t HiFlyingLightComponent::calculate_crc16_(const std::vector<uint8_t> &data, size_t start, size_t length, uint16_t initial) {
-  uint16_t crc = initial;
-  uint16_t poly = 0x1021;
-  
-  for (size_t i = 0; i < length && (start + i) < data.size(); i++) {
-    uint8_t byte_val = data[start + i];
-    crc ^= (byte_val << 8);
-    
-    for (int j = 0; j < 8; j++) {
-      if (crc & 0x8000) {
-        crc = ((crc << 1) ^ poly) & 0xffff;
-      } else {
-        crc = (crc << 1) & 0xffff;
-      }
-    }
+#ifdef USE_HIFLYING_LIGHT_METRICS
+  uint32_t start = micros();
+#endif
+  bool intermediate = this->adaptive_repeats_ && !final;
+  uint8_t group = HiFlyingRadio::get()->begin_group();
+  bool queued = false;
+  for (uint8_t i = 0; i < kept; i++) {
+    HiFlyingCommand command = commands[i].command;
+    queued |= this->queue_command_(command, commands[i].param, 0, intermediate && command != COMMAND_ON, group);
   }
-  
-  return crc;
+  if (queued && this->blocking_)
+    HiFlyingRadio::get()->flush();
+#ifdef USE_HIFLYING_LIGHT_METRICS
+  this->add_blocked_(start);
+#endif
 }
 
-// 反轉位
-uint8_t HiFlyingLightComponent::reverse_bits_(uint8_t byte_val) {
-  uint8_t result = 0;
-  for (int i = 0; i < 8; i++) {
-    if (byte_val & (1 << i)) {
-      result |= (1 << (7 - i));
-    }
+void HiFlyingLightComponent::queue_stream_(StreamSlot &slot, HiFlyingCommand command, uint16_t value, bool final) {
+  if (this->blocking_) {
+    this->send_command(command, value);
+    return;
   }
-  return result;
-}
 
-// 生成 HF 格式封包
-std::vector<uint8_t> HiFlyingLightComponent::generate_hf_packet_(const std::array<uint8_t, 5> &mac, uint8_t page, uint16_t counter,
-                                                               int8_t ctrl_code, const std::array<uint8_t, 3> &params) {
-  std::vector<uint8_t> packet(16);
-  
-  packet[0] = 0xff;
-  packet[1] = esp_random() & 0xff;  // 隨機值
-  packet[2] = counter & 0xff;
-  packet[3] = mac[0];
-  packet[4] = mac[1] & 0xf0;  // 清除低 4 位
-  packet[5] = 0;
-  packet[6] = 0;
-  packet[7] = ctrl_code & 0xff;
-  packet[8] = page & 0xff;
-  packet[9] = 0xff;
-  packet[10] = counter & 0xff;
-  packet[11] = params[0];
-  packet[12] = params[1];
-  packet[13] = params[2];
-  
-  // 特殊處理
-  if (ctrl_code != -76) {
-    this->apply_encryption_(packet, 9, 5, 0xaa);
-  } else {
-    packet[11] = 0xAA;
-    packet[12] = 0x66;
-    packet[13] = 0x55;
+  value = std::clamp<uint16_t>(value, 1, 0x3e8);
+  // 最後一次發送的是減少重複的中間值時，相同的最終值仍需以完整重複再發送一次
+  if (this->is_cached_(command, value) && !(final && slot.reduced)) {
+    // 燈具已經是最新值，取消尚未發送的舊值 (只計入 suppressed)
+    this->suppressed_++;
+    slot.value = 0;
+    return;
   }
-  
-  // 計算 CRC16
-  uint16_t crc = this->calculate_crc16_(packet, 0, 13, 0);
-  packet[14] = crc & 0xff;
-  packet[15] = (crc >> 8) & 0xff;
-  
-  // 最終加密
-  this->apply_encryption_(packet, 0, 16, 86);
-  
-  // 添加前綴和後綴
-  std::vector<uint8_t> final_packet(26);
-  final_packet[0] = 'H';
-  final_packet[1] = 'F';
-  final_packet[2] = 'K';
-  final_packet[3] = 'J';
-  std::copy(packet.begin(), packet.end(), final_packet.begin() + 4);
-  final_packet[20] = 0x10;
-  final_packet[21] = 0x11;
-  final_packet[22] = 0x12;
-  final_packet[23] = 0x13;
-  final_packet[24] = 0x14;
-  final_packet[25] = 0x15;
-  
-  return final_packet;
+  if (slot.value != 0) {
+    this->coalesced_++;
+    ESP_LOGV(TAG, "Instance %d replaced pending command %d value %d with %d", this->instance_id_, command, slot.value,
+             value);
+  }
+  slot.value = value;
+  slot.final = final;
+  this->flush_stream_();
 }
 
-// 位操作算法
-void HiFlyingLightComponent::apply_bit_operation_(std::vector<uint8_t> &data, size_t length, uint8_t key) {
-  uint8_t processed_key = ((key & 0x02) << 4) | (((((((key & 0x01) << 6) | 
-                         ((key & 0x20) >> 4)) | 1) | ((key & 0x10) >> 2)) | 
-                         (key & 0x08)) | ((key & 0x04) << 2)) & 0xff;
-  
-  for (size_t i = 0; i < length && i < data.size(); i++) {
-    uint8_t new_byte = 0;
-    for (int bit = 0; bit < 8; bit++) {
-      processed_key &= 0xff;
-      uint8_t bit_val = (processed_key & 0x40) >> 6;
-      bit_val = bit_val << bit;
-      bit_val ^= (data[i] & 0xff);
-      bit_val &= (1 << bit);
-      new_byte |= bit_val;
-      
-      processed_key <<= 1;
-      uint8_t carry = (processed_key >> 7) & 1;
-      processed_key &= 0xfe;
-      processed_key |= carry;
-      
-      uint8_t xor_val = carry << 4;
-      xor_val ^= processed_key;
-      xor_val &= 0x10;
-      processed_key &= 0xef;
-      processed_key |= xor_val;
-    }
-    data[i] = new_byte;
-  }
+// 以指定策略發送一個命令所需的空中時間 (單一格式或兩個廣播集時每次重複只需一個間隔)
+uint32_t HiFlyingLightComponent::airtime_budget_(const RepeatPolicy &policy) const {
+  uint8_t steps = 1;
+  if (this->protocol_ == PROTOCOL_BOTH && HiFlyingRadio::get()->get_advertiser()->num_sets() < 2)
+    steps = 2;
+  return uint32_t(policy.repeats) * policy.interval * steps;
 }
 
-// 生成 Deli16 格式封包
-std::vector<uint8_t> HiFlyingLightComponent::generate_deli16_packet_(const std::array<uint8_t, 5> &mac, uint8_t page, uint16_t counter,
-                                                                   int8_t ctrl_code, const std::array<uint8_t, 3> &params) {
-  std::vector<uint8_t> packet(26);
-  
-  // 構建數據
-  std::vector<uint8_t> data(8);
-  data[7] = (params[0] ^ counter) & 0xff;
-  data[6] = (params[2] ^ mac[0]) & 0xff;
-  data[5] = ((mac[1] ^ params[2]) ^ counter) & 0xff;
-  
-  uint8_t temp = params[2] ^ counter;
-  data[4] = (temp ^ ctrl_code) & 0xff;
-  data[3] = (temp ^ params[1]) & 0xff;
-  data[2] = (page ^ temp) & 0xff;
-  data[1] = (temp ^ params[0]) & 0xff;
-  data[0] = (temp ^ mac[0]) & 0xff;
-  
-  // CRC 計算
-  std::vector<uint8_t> crc_prefix = {0xcc, 0x55, 0xaa};
-  uint16_t crc = 0xffff;
-  
-  for (uint8_t b : crc_prefix) {
-    crc ^= (b << 8);
-    for (int i = 0; i < 8; i++) {
-      if (crc & 0x8000) {
-        crc = ((crc << 1) ^ 0x1021) & 0xffff;
-      } else {
-        crc = (crc << 1) & 0xffff;
-      }
-    }
-  }
-  
-  for (uint8_t b : data) {
-    uint8_t reversed_b = this->reverse_bits_(b);
-    crc ^= (reversed_b << 8);
-    for (int i = 0; i < 8; i++) {
-      if (crc & 0x8000) {
-        crc = ((crc << 1) ^ 0x1021) & 0xffff;
-      } else {
-        crc = (crc << 1) & 0xffff;
-      }
-    }
-  }
-  
-  uint16_t final_crc = crc ^ 0xffff;
-  final_crc = ((this->reverse_bits_(final_crc & 0xff) << 8) | 
-               this->reverse_bits_((final_crc >> 8) & 0xff)) & 0xffff;
-  
-  // 構建緩衝區
-  std::vector<uint8_t> temp_buffer(29);
-  temp_buffer[13] = 0x71;
-  temp_buffer[14] = 0x0f;
-  temp_buffer[15] = 0x55;
-  std::copy(crc_prefix.begin(), crc_prefix.end(), temp_buffer.begin() + 16);
-  std::copy(data.begin(), data.end(), temp_buffer.begin() + 19);
-  
-  for (int i = 13; i < 19; i++) {
-    temp_buffer[i] = this->reverse_bits_(temp_buffer[i]);
-  }
-  
-  temp_buffer[27] = final_crc & 0xff;
-  temp_buffer[28] = (final_crc >> 8) & 0xff;
-  
-  // 位操作處理
-  std::vector<uint8_t> mid_buffer(13);
-  std::copy(temp_buffer.begin() + 16, temp_buffer.begin() + 29, mid_buffer.begin());
-  this->apply_bit_operation_(mid_buffer, 13, 63);
-  std::copy(mid_buffer.begin(), mid_buffer.end(), temp_buffer.begin() + 16);
-  
-  this->apply_bit_operation_(temp_buffer, 29, 37);
-  
-  // 複製最終數據
-  std::copy(temp_buffer.begin() + 13, temp_buffer.begin() + 29, packet.begin());
-  
-  // 添加尾部序列
-  for (int i = 0; i < 10; i++) {
-    packet[16 + i] = (16 + i) & 0xff;
+// 本通道沒有待發送命令且距離上一次串流命令超過它的射頻預算時，發送最新的亮度或色溫
+void HiFlyingLightComponent::flush_stream_() {
+  if (this->brightness_slot_.value == 0 && this->color_temp_slot_.value == 0)
+    return;
+  uint32_t now = millis();
+  if (now - this->last_stream_ < this->last_stream_budget_ || HiFlyingRadio::get()->pending(this->instance_id_) > 0)
+    return;
+
+  // 兩個參數都有待發送值時輪流發送
+  bool color_temp =
+      this->color_temp_slot_.value != 0 && (this->brightness_slot_.value == 0 || this->color_temp_turn_);
+  HiFlyingCommand command = color_temp ? COMMAND_COLOR_TEMP : COMMAND_BRIGHTNESS;
+  StreamSlot &slot = color_temp ? this->color_temp_slot_ : this->brightness_slot_;
+  bool intermediate = this->adaptive_repeats_ && !slot.final;
+
+  // 串流節奏固定以完整重複計算，adaptive_repeats 減少的重複次數直接省下空中時間
+  this->last_stream_budget_ = this->airtime_budget_(this->base_policy_(command));
+#ifdef USE_HIFLYING_LIGHT_METRICS
+  uint32_t start = micros();
+#endif
+  this->queue_command_(command, slot.value, 0, intermediate);
+#ifdef USE_HIFLYING_LIGHT_METRICS
+  this->add_blocked_(start);
+#endif
+  slot.value = 0;
+  this->color_temp_turn_ = !color_temp;
+  this->last_stream_ = now;
+}
+
+// 發送由全域射頻仲裁器負責，所有實例共用同一個狀態機
+void HiFlyingLightComponent::loop() {
+  if (this->probe_protocol_ != PROTOCOL_AUTO)
+    this->probe_loop_();
+  this->flush_stream_();
+
+  auto *radio = HiFlyingRadio::get();
+  if (!radio->uses_task())
+    radio->loop();
+
+  // 沒有待發送命令時預先編碼 (射頻任務模式下由任務編碼，不需要預編碼)
+  if (this->pre_encode_ != PRE_ENCODE_NONE && !radio->uses_task() && this->probe_protocol_ == PROTOCOL_AUTO &&
+      radio->pending() == 0) {
+    this->pre_encode_loop_(this->protocol_);
   }
-  
-  return packet;
 }
 
-// 發送封包
-void HiFlyingLightComponent::send_packets_(const std::vector<uint8_t> &hf_packet, const std::vector<uint8_t> &deli16_packet) {
-#ifdef USE_ESP32
-  if (!esp32_ble::global_ble->is_active()) {
-    ESP_LOGE(TAG, "BLE not active, cannot send packets");
+void HiFlyingLightComponent::start_probe() {
+  ESP_LOGI(TAG, "Instance %d probing HF: press confirm when the lamp blinks", this->instance_id_);
+  this->probe_protocol_ = PROTOCOL_HF;
+  this->probe_step_ = 0;
+  this->probe_last_ = millis() - PROBE_STEP_MS;
+}
+
+void HiFlyingLightComponent::confirm_probe() {
+  if (this->probe_protocol_ == PROTOCOL_AUTO) {
+    ESP_LOGW(TAG, "Instance %d is not probing, nothing to confirm", this->instance_id_);
     return;
   }
 
-  esp_ble_adv_params_t adv_params = {};
-  adv_params.adv_int_min = 0x20;
-  adv_params.adv_int_max = 0x40;
-  adv_params.adv_type = ADV_TYPE_NONCONN_IND;
-  adv_params.own_addr_type = BLE_ADDR_TYPE_RANDOM;  // 使用隨機地址
-  adv_params.channel_map = ADV_CHNL_ALL;
-  adv_params.adv_filter_policy = ADV_FILTER_ALLOW_SCAN_ANY_CON_ANY;
+  this->protocol_ = this->probe_protocol_;
+  this->probe_protocol_ = PROTOCOL_AUTO;
+  uint8_t saved_protocol = this->protocol_;
+  this->protocol_pref_.save(&saved_protocol);
+  ESP_LOGI(TAG, "Instance %d lamp decodes %s, saved to preferences", this->instance_id_,
+           protocol_to_string(this->protocol_));
+  if (!this->protocol_auto_)
+    ESP_LOGW(TAG, "Set protocol: auto to use the probed format after reboot");
+}
 
-  for (int count = 0; count < this->packet_count_; count++) {
-    // 每次發送前更換隨機 MAC 地址
-    esp_bd_addr_t rand_addr;
-    for (int i = 0; i < 6; i++) {
-      rand_addr[i] = esp_random() & 0xFF;
-    }
-    // 確保是有效的隨機地址 (最高位需要設置為 1)
-    rand_addr[5] |= 0xC0;
-    
-    esp_ble_gap_set_rand_addr(rand_addr);
-    ESP_LOGD(TAG, "Set random MAC: %02X:%02X:%02X:%02X:%02X:%02X", 
-             rand_addr[5], rand_addr[4], rand_addr[3], rand_addr[2], rand_addr[1], rand_addr[0]);
-    
-    // 使用燈具要求的正確格式: 0201011B03 + 26字節封包
-    std::vector<uint8_t> adv_data_hf;
-    
-    // Flags: 02 01 01
-    adv_data_hf.push_back(0x02);  // Length
-    adv_data_hf.push_back(0x01);  // AD Type: Flags
-    adv_data_hf.push_back(0x01);  // Flags value
-    
-    // Service UUIDs: 1B 03 + data
-    adv_data_hf.push_back(0x1B);  // Length (27 bytes = 1 + 26)
-    adv_data_hf.push_back(0x03);  // AD Type: Complete List of 16-bit Service Class UUIDs
-    adv_data_hf.insert(adv_data_hf.end(), hf_packet.begin(), hf_packet.end());
-    
-    ESP_LOGD(TAG, "Sending HF packet (%d bytes): %s", adv_data_hf.size(), 
-             format_hex_pretty(adv_data_hf.data(), adv_data_hf.size()).c_str());
-    
-    esp_ble_gap_config_adv_data_raw(adv_data_hf.data(), adv_data_hf.size());
-    esp_ble_gap_start_advertising(&adv_params);
-    delay(this->packet_interval_);
-    esp_ble_gap_stop_advertising();
-    
-    // 更換另一個隨機 MAC 地址用於 Deli16 封包
-    for (int i = 0; i < 6; i++) {
-      rand_addr[i] = esp_random() & 0xFF;
+// 探測: 每個格式輪流發送 OFF/ON 讓燈具閃爍，HF 之後換 Deli16，都沒有確認則結束
+void HiFlyingLightComponent::probe_loop_() {
+  uint32_t now = millis();
+  if (now - this->probe_last_ < PROBE_STEP_MS)
+    return;
+  this->probe_last_ = now;
+
+  if (this->probe_step_ == PROBE_STEPS) {
+    if (this->probe_protocol_ == PROTOCOL_DELI16) {
+      ESP_LOGW(TAG, "Instance %d probe finished without confirmation, keeping %s", this->instance_id_,
+               protocol_to_string(this->protocol_));
+      this->probe_protocol_ = PROTOCOL_AUTO;
+      return;
     }
-    rand_addr[5] |= 0xC0;
-    esp_ble_gap_set_rand_addr(rand_addr);
-    ESP_LOGD(TAG, "Set random MAC: %02X:%02X:%02X:%02X:%02X:%02X", 
-             rand_addr[5], rand_addr[4], rand_addr[3], rand_addr[2], rand_addr[1], rand_addr[0]);
-    
-    // 同樣處理 Deli16 封包
-    std::vector<uint8_t> adv_data_deli16;
-    
-    // Flags: 02 01 01
-    adv_data_deli16.push_back(0x02);  // Length
-    adv_data_deli16.push_back(0x01);  // AD Type: Flags
-    adv_data_deli16.push_back(0x01);  // Flags value
-    
-    // Service UUIDs: 1B 03 + data
-    adv_data_deli16.push_back(0x1B);  // Length (27 bytes = 1 + 26)
-    adv_data_deli16.push_back(0x03);  // AD Type: Complete List of 16-bit Service Class UUIDs
-    adv_data_deli16.insert(adv_data_deli16.end(), deli16_packet.begin(), deli16_packet.end());
-    
-    ESP_LOGD(TAG, "Sending Deli16 packet (%d bytes): %s", adv_data_deli16.size(), 
-             format_hex_pretty(adv_data_deli16.data(), adv_data_deli16.size()).c_str());
-    
-    esp_ble_gap_config_adv_data_raw(adv_data_deli16.data(), adv_data_deli16.size());
-    esp_ble_gap_start_advertising(&adv_params);
-    delay(this->packet_interval_);
-    esp_ble_gap_stop_advertising();
+    ESP_LOGI(TAG, "Instance %d probing Deli16: press confirm when the lamp blinks", this->instance_id_);
+    this->probe_protocol_ = PROTOCOL_DELI16;
+    this->probe_step_ = 0;
   }
+
+  this->queue_command_(this->probe_step_ % 2 == 0 ? COMMAND_OFF : COMMAND_ON, 0, 0);
+  this->probe_step_++;
+}
+
+void HiFlyingLightComponent::dump_trace() {
+#ifdef USE_HIFLYING_LIGHT_TRACE
+  HiFlyingRadio::get()->dump_trace();
+#else
+  ESP_LOGW(TAG, "Packet trace is not enabled, set trace: true");
 #endif
+}
 
-  ESP_LOGD(TAG, "Sent packets (count: %d, interval: %d ms)", this->packet_count_, this->packet_interval_);
+bool HiFlyingLightComponent::get_command_info(HiFlyingCommand command, CommandInfo &info) {
+  auto it = command_map_.find(command);
+  if (it == command_map_.end())
+    return false;
+  info = it->second;
+  return true;
 }
 
 // HiFlyingLightOutput 實現
-light::LightTraits HiFlyingLightOutput::get_traits() {
+light::LightTraits HiFlyingLightOutputBase::get_traits() {
   auto traits = light::LightTraits();
   traits.set_supported_color_modes({light::ColorMode::BRIGHTNESS});
   
@@ -520,25 +917,33 @@ void HiFlyingLightOutput::write_state(light::LightState *state) {
     return;
   }
 
+  this->write_values_(state);
+}
+
+void HiFlyingLightOutputBase::write_values_(light::LightState *state) {
   float brightness;
   state->current_values_as_brightness(&brightness);
+  // 目前值已到達目標值時為最終值，漸變期間的都是中間值
+  bool final = state->current_values == state->remote_values;
   
   // 檢查燈是否需要開關
   if (brightness == 0.0f && this->last_brightness_ > 0.0f) {
     // 關燈
-    this->parent_->turn_off();
+    this->turn_off_();
     this->last_brightness_ = brightness;
     return;
-  } else if (brightness > 0.0f && this->last_brightness_ == 0.0f) {
-    // 開燈
-    this->parent_->turn_on();
   }
+  bool turn_on = brightness > 0.0f && this->last_brightness_ == 0.0f;
+  uint16_t brightness_value = 0;
+  uint16_t color_temp_value = 0;
 
   // 亮度控制 (將 0.0-1.0 映射到 1-1000)
-  if (brightness > 0.0f && abs(brightness - this->last_brightness_) > 0.01f) {
-    uint16_t brightness_value = static_cast<uint16_t>(brightness * 999.0f) + 1;
-    this->parent_->set_brightness(brightness_value);
+  // 漸變結束時即使變化很小也要發送最終值 (之前的中間值可能只發送了一次)
+  if (brightness > 0.0f &&
+      (abs(brightness - this->last_brightness_) > 0.01f || (final && !this->last_brightness_final_))) {
+    brightness_value = static_cast<uint16_t>(brightness * 999.0f) + 1;
     this->last_brightness_ = brightness;
+    this->last_brightness_final_ = final;
   }
 
   // 色溫控制
@@ -546,16 +951,28 @@ void HiFlyingLightOutput::write_state(light::LightState *state) {
     auto current_values = state->current_values;
     if (current_values.get_color_mode() == light::ColorMode::COLOR_TEMPERATURE) {
       float mired = current_values.get_color_temperature();
-      if (abs(mired - this->last_color_temp_) > 1.0f) {
+      if (abs(mired - this->last_color_temp_) > 1.0f || (final && !this->last_color_temp_final_)) {
         // 將 mired 值轉換為 1-1000 範圍
         float normalized = (mired - 153.0f) / (370.0f - 153.0f);  // 正規化到 0-1
         normalized = 1.0f - normalized;  // 反轉 (低mired=冷光=高數值)
-        uint16_t color_temp_value = static_cast<uint16_t>(normalized * 999.0f) + 1;
-        this->parent_->set_color_temperature(color_temp_value);
+        color_temp_value = static_cast<uint16_t>(normalized * 999.0f) + 1;
         this->last_color_temp_ = mired;
+        this->last_color_temp_final_ = final;
       }
     }
   }
+
+  if (turn_on || brightness_value != 0 || color_temp_value != 0)
+    this->write_commands_(turn_on, brightness_value, color_temp_value, final);
+}
+
+void HiFlyingLightOutputBase::write_commands_(bool turn_on, uint16_t brightness, uint16_t color_temp, bool final) {
+  if (turn_on)
+    this->turn_on_();
+  if (brightness != 0)
+    this->set_brightness_(brightness, final);
+  if (color_temp != 0)
+    this->set_color_temperature_(color_temp, final);
 }
 
 // HiFlyingLightPairButton 實現
@@ -569,5 +986,32 @@ void HiFlyingLightPairButton::press_action() {
   this->parent_->pair();
 }
 
+void HiFlyingLightProbeButton::press_action() {
+  if (this->parent_ == nullptr) {
+    ESP_LOGE(TAG, "Parent component not set for probe button");
+    return;
+  }
+
+  this->parent_->start_probe();
+}
+
+void HiFlyingLightProbeConfirmButton::press_action() {
+  if (this->parent_ == nullptr) {
+    ESP_LOGE(TAG, "Parent component not set for probe confirm button");
+    return;
+  }
+
+  this->parent_->confirm_probe();
+}
+
+void HiFlyingLightTraceDumpButton::press_action() {
+  if (this->parent_ == nullptr) {
+    ESP_LOGE(TAG, "Parent component not set for trace dump button");
+    return;
+  }
+
+  this->parent_->dump_trace();
+}
+
 }  // namespace hiflying_light
 }  // namespace esphome 
\ No newline at end of file
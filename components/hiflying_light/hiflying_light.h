@@ -5,6 +5,8 @@
 #include "esphome/components/light/light_output.h"
 #include "esphome/components/light/light_state.h"
 #include "esphome/components/button/button.h"
+#include "hiflying_protocol.h"
+#include "hiflying_radio.h"
 
 #include <vector>
 #include <array>
@@ -26,9 +28,60 @@ struct CommandInfo {
   int8_t ctrl_code;
 };
 
+// 每種命令的重複策略 (repeats 為 0 表示沿用 packet_count / packet_interval)
+struct RepeatPolicy {
+  uint8_t repeats{0};
+  uint16_t interval{0};  // ms
+  uint8_t priority{0};   // 佇列已滿時先丟棄優先級較低的命令
+};
+
+static const uint8_t PRIORITY_STREAM = 0;    // 亮度、色溫
+static const uint8_t PRIORITY_CRITICAL = 1;  // 配對、開、關
+
+// 高優先級命令入隊時，同一通道中尚未發送且已等待超過這個時間的低優先級命令視為過期 (ms)
+static const uint32_t DEFAULT_STALE_DEADLINE = 100;
+
+// 策略表索引 (依 HiFlyingCommand，見 policy_index())
+static const uint8_t NUM_COMMANDS = 5;
+
+// 亮度/色溫串流的待發送值，final 表示漸變已結束 (最後一個值)
+struct StreamSlot {
+  uint16_t value{0};  // 0 表示沒有待發送值
+  bool final{true};
+  bool reduced{false};  // 上一個發送的值是減少重複的中間值
+};
+
+// 閒置時預先編碼的命令
+enum PreEncodeMode : uint8_t {
+  PRE_ENCODE_NONE = 0,
+  PRE_ENCODE_ON_OFF,
+  PRE_ENCODE_LAST_BRIGHTNESS,  // ON、OFF 以及最後發送的亮度
+};
+
+// 下一個計數器的預編碼 AD 幀 (protocol 為 PROTOCOL_AUTO 表示無效)
+struct PreEncodedFrames {
+  AdvFrame hf_frame;
+  AdvFrame deli16_frame;
+  uint16_t counter{0};
+  uint16_t param{0};
+  HiFlyingProtocol protocol{PROTOCOL_AUTO};
+};
+
+class HiFlyingLightComponent;
+
+// 場景中的單一燈具命令
+struct SceneEntry {
+  HiFlyingLightComponent *light;
+  HiFlyingCommand command;
+  uint16_t param;
+};
+
 class HiFlyingLightComponent : public Component {
  public:
+  HiFlyingLightComponent();
+
   void setup() override;
+  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::AFTER_BLUETOOTH; }
 
@@ -37,16 +90,57 @@ class HiFlyingLightComponent : public Component {
   void set_packet_interval(uint32_t interval) { this->packet_interval_ = interval; }
   void set_packet_count(uint8_t count) { this->packet_count_ = count; }
   void set_counter(uint16_t counter) { this->counter_ = counter; }
-
-
+  void set_counter_lease(uint16_t lease) { this->counter_lease_ = lease; }
+  void set_rtc_counter(bool rtc_counter) { this->rtc_counter_ = rtc_counter; }
+  void set_blocking(bool blocking) { this->blocking_ = blocking; }
+  void set_radio_task(bool radio_task) { this->radio_task_enabled_ = radio_task; }
+  void set_protocol(HiFlyingProtocol protocol) { this->protocol_ = protocol; }
+  void set_pre_encode(PreEncodeMode mode) { this->pre_encode_ = mode; }
+  void set_repeat_policy(HiFlyingCommand command, uint8_t repeats, uint32_t interval, uint8_t priority);
+  void set_adaptive_repeats(bool adaptive) { this->adaptive_repeats_ = adaptive; }
+  void set_compound_commands(bool compound) { this->compound_commands_ = compound; }
+  void set_framing(AdvFraming framing) { this->framing_ = framing; }
+  void set_preemption(bool preemption) { this->preemption_ = preemption; }
+  void set_stale_deadline(uint32_t deadline) { this->stale_deadline_ = deadline; }
 
   // 控制方法
   void send_command(HiFlyingCommand command, uint16_t param = 0);
   void pair();
   void turn_on();
   void turn_off();
-  void set_brightness(uint16_t brightness);
-  void set_color_temperature(uint16_t color_temp);
+  // final 為 false 表示漸變中的中間值 (adaptive_repeats 時以較少重複發送)
+  void set_brightness(uint16_t brightness, bool final = true);
+  void set_color_temperature(uint16_t color_temp, bool final = true);
+  // 開燈、亮度與色溫一起改變 (0 表示不改變): 以連續的計數器編碼並在同一個突發中交錯發送
+  void send_compound(bool turn_on, uint16_t brightness, uint16_t color_temp, bool final = true);
+
+  // 協議探測: 依序只用 HF、只用 Deli16 讓燈具閃爍，看到閃爍時呼叫 confirm_probe() 保存結果
+  void start_probe();
+  void confirm_probe();
+  HiFlyingProtocol get_protocol() const { return this->protocol_; }
+
+  // 狀態快取: 記錄燈具最後收到的開關與亮度/色溫 (燈具刻度 1-1000)，相同的命令不再發送
+  // 被動監聽到遙控器命令時也會更新快取
+  void update_cache(HiFlyingCommand command, uint16_t param);
+  void invalidate_cache();
+  // 由封包中的 ctrl_code 反查命令
+  static bool command_from_ctrl_code(int8_t ctrl_code, HiFlyingCommand &command);
+  static bool get_command_info(HiFlyingCommand command, CommandInfo &info);
+
+  // 執行期統計 (累計值，計時類統計只在設定 metrics 感測器時收集)
+  uint32_t get_commands() const { return this->commands_; }
+  uint32_t get_coalesced() const { return this->coalesced_; }
+  uint32_t get_suppressed() const { return this->suppressed_; }
+  uint32_t get_flash_saves() const { return this->flash_saves_; }
+  uint32_t get_blocked_us_total() const { return this->blocked_us_total_; }
+  // 回傳上次呼叫以來單一命令阻塞 loop 的最長時間並重新開始統計
+  uint32_t take_blocked_us_max();
+
+  // 輸出並清空發送路徑的二進位封包追蹤 (trace: true 時才記錄，所有實例共用)
+  void dump_trace();
+
+  // 多燈場景: 一次編碼所有燈具的封包並以單一交錯突發發送
+  static void send_scene(const std::vector<SceneEntry> &entries);
 
   // 獲取設備 MAC 地址
   std::array<uint8_t, 6> get_device_mac();
@@ -56,45 +150,131 @@ class HiFlyingLightComponent : public Component {
   uint32_t packet_interval_{10};  // milliseconds
   uint8_t packet_count_{3};
   uint16_t counter_{1};
+  uint16_t counter_lease_{64};
+  uint16_t lease_end_{1};  // 已保存到 flash 的租約結束值
+  bool rtc_counter_{false};
+  bool blocking_{false};
+  bool radio_task_enabled_{false};
+  HiFlyingProtocol protocol_{PROTOCOL_BOTH};
+  bool protocol_auto_{false};  // protocol: auto，setup() 時從探測結果解析
+  AdvFraming framing_{FRAMING_UUID_LIST};
 
-  ESPPreferenceObject pref_;
+  // 探測狀態 (probe_protocol_ 為 PROTOCOL_AUTO 表示未在探測)
+  HiFlyingProtocol probe_protocol_{PROTOCOL_AUTO};
+  uint8_t probe_step_{0};
+  uint32_t probe_last_{0};
+
+  // 亮度/色溫串流 (例如 transition 漸變): 每個參數只保留最新值，
+  // 上一個命令發送完且超過它的射頻預算時間後才發送下一個，最終值一定會發送
+  StreamSlot brightness_slot_;
+  StreamSlot color_temp_slot_;
+  bool color_temp_turn_{false};
+  uint32_t last_stream_{0};
+  uint32_t last_stream_budget_{0};
+  uint32_t coalesced_{0};
 
-  // 加密相關
-  std::array<uint8_t, 16> get_encryption_table_();
-  void apply_encryption_(std::vector<uint8_t> &data, size_t start, size_t length, uint8_t key);
-  std::array<uint8_t, 8> tea_encrypt_(const std::array<uint8_t, 8> &data);
-  uint16_t calculate_crc16_(const std::vector<uint8_t> &data, size_t start, size_t length, uint16_t initial = 0);
-  uint8_t reverse_bits_(uint8_t byte_val);
+  // 重複策略: 以 policy_index() 索引，setup() 時補上預設值
+  std::array<RepeatPolicy, NUM_COMMANDS> policies_{};
+  bool adaptive_repeats_{false};
+  bool compound_commands_{true};
+  // 搶佔: 高優先級命令縮短本通道正在發送的低優先級命令並丟棄過期的命令
+  bool preemption_{true};
+  uint32_t stale_deadline_{DEFAULT_STALE_DEADLINE};
 
-  // 封包生成
-  std::vector<uint8_t> generate_hf_packet_(const std::array<uint8_t, 5> &mac, uint8_t page, uint16_t counter,
-                                          int8_t ctrl_code, const std::array<uint8_t, 3> &params);
-  std::vector<uint8_t> generate_deli16_packet_(const std::array<uint8_t, 5> &mac, uint8_t page, uint16_t counter,
-                                              int8_t ctrl_code, const std::array<uint8_t, 3> &params);
-  void apply_bit_operation_(std::vector<uint8_t> &data, size_t length, uint8_t key);
+  // 0 表示未知 (重啟後或配對後第一個命令一定會發送)
+  uint8_t cached_power_{0};  // COMMAND_ON / COMMAND_OFF
+  uint16_t cached_brightness_{0};
+  uint16_t cached_color_temp_{0};
+  uint8_t lost_seen_{0};  // 上一次看到的仲裁器遺失數 (HiFlyingRadio::get_lost)
+  uint32_t suppressed_{0};
+  uint32_t commands_{0};
+  uint32_t flash_saves_{0};
+  uint32_t blocked_us_total_{0};
+  uint32_t blocked_us_max_{0};
+
+  // 預編碼槽位: ON、OFF、最後亮度
+  PreEncodeMode pre_encode_{PRE_ENCODE_NONE};
+  std::array<PreEncodedFrames, 3> pre_encoded_{};
+  uint32_t pre_encoded_hits_{0};
+
+  ESPPreferenceObject pref_;
+  ESPPreferenceObject protocol_pref_;
 
-  // 發送封包
-  void send_packets_(const std::vector<uint8_t> &hf_packet, const std::vector<uint8_t> &deli16_packet);
+  bool queue_command_(HiFlyingCommand command, uint16_t param, uint8_t burst, bool intermediate = false,
+                      uint8_t group = 0);
+  RepeatPolicy base_policy_(HiFlyingCommand command) const;
+  RepeatPolicy policy_for_(HiFlyingCommand command, bool intermediate) const;
+  bool is_cached_(HiFlyingCommand command, uint16_t param);
+  std::array<uint8_t, 5> get_mac_5_();
+  void encode_frames_(const CommandInfo &cmd_info, const std::array<uint8_t, 3> &params, uint16_t counter,
+                      HiFlyingProtocol protocol, AdvFrame &hf_frame, AdvFrame &deli16_frame);
+  void pre_encode_loop_(HiFlyingProtocol protocol);
+  bool take_pre_encoded_(HiFlyingCommand command, uint16_t param, HiFlyingProtocol protocol, TxJob &job);
+  void probe_loop_();
+  void queue_stream_(StreamSlot &slot, HiFlyingCommand command, uint16_t value, bool final);
+  void flush_stream_();
+#ifdef USE_HIFLYING_LIGHT_METRICS
+  void add_blocked_(uint32_t start);
+#endif
+  uint32_t airtime_budget_(const RepeatPolicy &policy) const;
+  void advance_counter_();
+#ifdef USE_HIFLYING_LIGHT_SELF_TEST
+  bool run_self_test_();
+  bool run_batch_self_test_(uint32_t &batch_us, uint32_t &single_us);
+#endif
+
+  // 封包生成 (編碼核心見 hiflying_protocol.h，此處注入廣播器提供的隨機數)
+  Packet generate_hf_packet_(const std::array<uint8_t, 5> &mac, uint8_t page, uint16_t counter, int8_t ctrl_code,
+                             const std::array<uint8_t, 3> &params);
+  Packet generate_deli16_packet_(const std::array<uint8_t, 5> &mac, uint8_t page, uint16_t counter, int8_t ctrl_code,
+                                 const std::array<uint8_t, 3> &params);
 
   // 命令映射
   static const std::map<HiFlyingCommand, CommandInfo> command_map_;
 };
 
-class HiFlyingLightOutput : public light::LightOutput {
+// light 平台共用部分: 把 LightState 轉成燈具刻度 (1-1000) 的開關、亮度與色溫命令
+class HiFlyingLightOutputBase : public light::LightOutput {
  public:
-  void set_parent(HiFlyingLightComponent *parent) { this->parent_ = parent; }
   void set_color_temperature_support(bool support) { this->color_temperature_support_ = support; }
 
   light::LightTraits get_traits() override;
   void setup_state(light::LightState *state) override { this->state_ = state; }
-  void write_state(light::LightState *state) override;
 
  protected:
-  HiFlyingLightComponent *parent_{nullptr};
+  void write_values_(light::LightState *state);
+  virtual void turn_on_() = 0;
+  virtual void turn_off_() = 0;
+  virtual void set_brightness_(uint16_t brightness, bool final) = 0;
+  virtual void set_color_temperature_(uint16_t color_temp, bool final) = 0;
+  // 同一次 write_state 中的所有命令 (0 表示不改變)，預設逐一發送
+  virtual void write_commands_(bool turn_on, uint16_t brightness, uint16_t color_temp, bool final);
+
   light::LightState *state_{nullptr};
   bool color_temperature_support_{false};
   float last_brightness_{0.0f};
   float last_color_temp_{300.0f};  // mired 值
+  bool last_brightness_final_{true};
+  bool last_color_temp_final_{true};
+};
+
+class HiFlyingLightOutput : public HiFlyingLightOutputBase {
+ public:
+  void set_parent(HiFlyingLightComponent *parent) { this->parent_ = parent; }
+  void write_state(light::LightState *state) override;
+
+ protected:
+  void turn_on_() override { this->parent_->turn_on(); }
+  void turn_off_() override { this->parent_->turn_off(); }
+  void set_brightness_(uint16_t brightness, bool final) override { this->parent_->set_brightness(brightness, final); }
+  void set_color_temperature_(uint16_t color_temp, bool final) override {
+    this->parent_->set_color_temperature(color_temp, final);
+  }
+  void write_commands_(bool turn_on, uint16_t brightness, uint16_t color_temp, bool final) override {
+    this->parent_->send_compound(turn_on, brightness, color_temp, final);
+  }
+
+  HiFlyingLightComponent *parent_{nullptr};
 };
 
 class HiFlyingLightPairButton : public button::Button {
@@ -106,5 +286,20 @@ class HiFlyingLightPairButton : public button::Button {
   HiFlyingLightComponent *parent_{nullptr};
 };
 
+class HiFlyingLightProbeButton : public HiFlyingLightPairButton {
+ protected:
+  void press_action() override;
+};
+
+class HiFlyingLightProbeConfirmButton : public HiFlyingLightPairButton {
+ protected:
+  void press_action() override;
+};
+
+class HiFlyingLightTraceDumpButton : public HiFlyingLightPairButton {
+ protected:
+  void press_action() override;
+};
+
 }  // namespace hiflying_light
 }  // namespace esphome 
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "hiflying_metrics.h"
+
+#ifdef USE_HIFLYING_LIGHT_METRICS
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace hiflying_light {
+
+static const char *const TAG = "hiflying_light.metrics";
+
+void HiFlyingLightMetrics::setup() { this->last_update_ = millis(); }
+
+void HiFlyingLightMetrics::update() {
+  auto *radio = HiFlyingRadio::get();
+  uint32_t now = millis();
+  uint32_t elapsed = now - this->last_update_;
+  this->last_update_ = now;
+
+  // 編碼時間為全域統計 (所有實例共用仲裁器)
+  const EncodeStats &stats = radio->get_encode_stats();
+  uint32_t frames = stats.frames - this->last_frames_;
+  uint32_t encode_us = stats.total_us - this->last_encode_us_;
+  this->last_frames_ = stats.frames;
+  this->last_encode_us_ = stats.total_us;
+  if (this->encode_time_sensor_ != nullptr && frames > 0)
+    this->encode_time_sensor_->publish_state(float(encode_us) / frames);
+
+  uint32_t blocked_us = this->parent_->take_blocked_us_max();
+  if (this->blocked_time_sensor_ != nullptr)
+    this->blocked_time_sensor_->publish_state(blocked_us / 1000.0f);
+
+  uint32_t commands = this->parent_->get_commands();
+  if (this->commands_per_minute_sensor_ != nullptr && elapsed > 0)
+    this->commands_per_minute_sensor_->publish_state((commands - this->last_commands_) * 60000.0f / elapsed);
+  this->last_commands_ = commands;
+
+  if (this->queue_depth_sensor_ != nullptr)
+    this->queue_depth_sensor_->publish_state(radio->pending());
+  if (this->dropped_sensor_ != nullptr)
+    this->dropped_sensor_->publish_state(radio->get_dropped());
+  if (this->coalesced_sensor_ != nullptr)
+    this->coalesced_sensor_->publish_state(this->parent_->get_coalesced());
+  if (this->suppressed_sensor_ != nullptr)
+    this->suppressed_sensor_->publish_state(this->parent_->get_suppressed());
+  if (this->flash_saves_sensor_ != nullptr)
+    this->flash_saves_sensor_->publish_state(this->parent_->get_flash_saves());
+}
+
+void HiFlyingLightMetrics::dump_config() {
+  ESP_LOGCONFIG(TAG, "HiFlying Light Metrics:");
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "Encode Time", this->encode_time_sensor_);
+  LOG_SENSOR("  ", "Blocked Time", this->blocked_time_sensor_);
+  LOG_SENSOR("  ", "Commands Per Minute", this->commands_per_minute_sensor_);
+  LOG_SENSOR("  ", "Queue Depth", this->queue_depth_sensor_);
+  LOG_SENSOR("  ", "Dropped", this->dropped_sensor_);
+  LOG_SENSOR("  ", "Coalesced", this->coalesced_sensor_);
+  LOG_SENSOR("  ", "Suppressed", this->suppressed_sensor_);
+  LOG_SENSOR("  ", "Flash Saves", this->flash_saves_sensor_);
+}
+
+}  // namespace hiflying_light
+}  // namespace esphome
+
+#endif  // USE_HIFLYING_LIGHT_METRICS
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_HIFLYING_LIGHT_METRICS
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "hiflying_light.h"
+
+namespace esphome {
+namespace hiflying_light {
+
+// 執行期統計感測器: 每個 update_interval 發布一次，區間類數值 (平均/最大/每分鐘) 只統計該區間
+class HiFlyingLightMetrics : public PollingComponent {
+ public:
+  void set_parent(HiFlyingLightComponent *parent) { this->parent_ = parent; }
+  void set_encode_time_sensor(sensor::Sensor *sensor) { this->encode_time_sensor_ = sensor; }
+  void set_blocked_time_sensor(sensor::Sensor *sensor) { this->blocked_time_sensor_ = sensor; }
+  void set_commands_per_minute_sensor(sensor::Sensor *sensor) { this->commands_per_minute_sensor_ = sensor; }
+  void set_queue_depth_sensor(sensor::Sensor *sensor) { this->queue_depth_sensor_ = sensor; }
+  void set_dropped_sensor(sensor::Sensor *sensor) { this->dropped_sensor_ = sensor; }
+  void set_coalesced_sensor(sensor::Sensor *sensor) { this->coalesced_sensor_ = sensor; }
+  void set_suppressed_sensor(sensor::Sensor *sensor) { this->suppressed_sensor_ = sensor; }
+  void set_flash_saves_sensor(sensor::Sensor *sensor) { this->flash_saves_sensor_ = sensor; }
+
+  void setup() override;
+  void update() override;
+  void dump_config() override;
+
+ protected:
+  HiFlyingLightComponent *parent_{nullptr};
+  sensor::Sensor *encode_time_sensor_{nullptr};
+  sensor::Sensor *blocked_time_sensor_{nullptr};
+  sensor::Sensor *commands_per_minute_sensor_{nullptr};
+  sensor::Sensor *queue_depth_sensor_{nullptr};
+  sensor::Sensor *dropped_sensor_{nullptr};
+  sensor::Sensor *coalesced_sensor_{nullptr};
+  sensor::Sensor *suppressed_sensor_{nullptr};
+  sensor::Sensor *flash_saves_sensor_{nullptr};
+
+  // 上一次發布時的累計值
+  uint32_t last_update_{0};
+  uint32_t last_commands_{0};
+  uint32_t last_frames_{0};
+  uint32_t last_encode_us_{0};
+};
+
+}  // namespace hiflying_light
+}  // namespace esphome
+
+#endif  // USE_HIFLYING_LIGHT_METRICS
@@ -0,0 +1,452 @@
+#pragma once
+
+// HiFlying 協議編碼核心 (TEA 加密表、CRC16、資料白化、HF/Deli16 封包生成)
+// 僅依賴標準函式庫，可在 Linux 主機上獨立編譯；隨機數與 MAC 由呼叫端注入
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace hiflying_light {
+
+// 26 字節協議封包與 31 字節廣播 AD 幀 (02 01 01 1B 03 + 封包)
+using Packet = std::array<uint8_t, 26>;
+using AdvFrame = std::array<uint8_t, 31>;
+
+// TEA 加密實現 (constexpr，輸入皆為常數，於編譯期完成)
+inline constexpr char TEA_KEY[] = "!hIflIngCypcal@#";
+
+constexpr uint32_t tea_key_word(int offset) {
+  return uint32_t(uint8_t(TEA_KEY[offset])) | (uint32_t(uint8_t(TEA_KEY[offset + 1])) << 8) |
+         (uint32_t(uint8_t(TEA_KEY[offset + 2])) << 16) | (uint32_t(uint8_t(TEA_KEY[offset + 3])) << 24);
+}
+
+constexpr std::array<uint8_t, 8> tea_encrypt(const std::array<uint8_t, 8> &data) {
+  uint32_t v0 = uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+  uint32_t v1 = uint32_t(data[4]) | (uint32_t(data[5]) << 8) | (uint32_t(data[6]) << 16) | (uint32_t(data[7]) << 24);
+
+  const uint32_t k0 = tea_key_word(0);
+  const uint32_t k1 = tea_key_word(4);
+  const uint32_t k2 = tea_key_word(8);
+  const uint32_t k3 = tea_key_word(12);
+
+  const uint32_t delta = 0x9e3779b9;
+  uint32_t sum_val = 0xc6ef3720;
+
+  for (int i = 0; i < 32; i++) {
+    v1 -= ((v0 << 4) + k2) ^ (v0 + sum_val) ^ ((v0 >> 5) + k3);
+    v0 -= ((v1 << 4) + k0) ^ (v1 + sum_val) ^ ((v1 >> 5) + k1);
+    sum_val -= delta;
+  }
+
+  return {uint8_t(v0), uint8_t(v0 >> 8), uint8_t(v0 >> 16), uint8_t(v0 >> 24),
+          uint8_t(v1), uint8_t(v1 >> 8), uint8_t(v1 >> 16), uint8_t(v1 >> 24)};
+}
+
+// 加密表: 由固定基礎密鑰經 TEA 產生，所有實例共用同一份編譯期常數
+constexpr std::array<uint8_t, 16> make_encryption_table() {
+  const std::array<uint8_t, 8> part1 = {0x52, 0xea, 0x73, 0xff, 0x49, 0x60, 0xbf, 0x56};
+  const std::array<uint8_t, 8> part2 = {0x42, 0x05, 0x07, 0xe8, 0xd3, 0xa7, 0xb9, 0x9d};
+
+  auto encrypted1 = tea_encrypt(part1);
+  auto encrypted2 = tea_encrypt(part2);
+
+  std::array<uint8_t, 16> table{};
+  for (size_t i = 0; i < 8; i++) {
+    table[i] = encrypted1[i];
+    table[i + 8] = encrypted2[i];
+  }
+  return table;
+}
+
+inline constexpr std::array<uint8_t, 16> ENCRYPTION_TABLE = make_encryption_table();
+
+// 應用加密
+inline void apply_encryption(uint8_t *data, size_t length, uint8_t key) {
+  const auto &enc_table = ENCRYPTION_TABLE;
+
+  uint8_t b = data[1];
+  uint8_t i = b & 0x0f;
+  b = enc_table[((b >> 4) & 0x0f) ^ i];
+
+  for (size_t j = 0; j < length; j++) {
+    uint8_t i2 = data[j] ^ b;
+    uint8_t i3 = (j + key) & 0x0f;
+    data[j] = ((i2 & 0xff) + enc_table[i3 & 0xff]) & 0xff;
+  }
+}
+
+// 解除加密: b 由加密前的 data[1] 決定，只有 16 種可能，逐一嘗試並回傳與 data[1] 一致的候選
+// (candidate 為起始嘗試索引，多個候選時呼叫端以 CRC 等欄位驗證後可從下一個索引繼續)
+inline int remove_encryption(uint8_t *data, size_t length, uint8_t key, int candidate = 0) {
+  const auto &enc_table = ENCRYPTION_TABLE;
+
+  uint8_t y = uint8_t(data[1] - enc_table[(1 + key) & 0x0f]);
+  for (int idx = candidate; idx < 16; idx++) {
+    uint8_t b = enc_table[idx];
+    uint8_t x = y ^ b;
+    if ((((x >> 4) & 0x0f) ^ (x & 0x0f)) != idx)
+      continue;
+    for (size_t j = 0; j < length; j++) {
+      data[j] = uint8_t(data[j] - enc_table[(j + key) & 0x0f]) ^ b;
+    }
+    return idx;
+  }
+  return -1;
+}
+
+// CRC-16/CCITT 引擎 (poly 0x1021)，查表於編譯期產生
+// 定義 USE_HIFLYING_LIGHT_CRC_NIBBLE_TABLE 時改用 16 項半字節表以節省 flash
+inline constexpr uint16_t CRC16_POLY = 0x1021;
+inline constexpr uint16_t CRC16_POLY_REFLECTED = 0x8408;
+
+#ifdef USE_HIFLYING_LIGHT_CRC_NIBBLE_TABLE
+inline constexpr size_t CRC16_TABLE_BITS = 4;
+#else
+inline constexpr size_t CRC16_TABLE_BITS = 8;
+#endif
+inline constexpr size_t CRC16_TABLE_SIZE = 1 << CRC16_TABLE_BITS;
+
+template<bool Reflected> constexpr std::array<uint16_t, CRC16_TABLE_SIZE> make_crc16_table() {
+  std::array<uint16_t, CRC16_TABLE_SIZE> table{};
+  for (size_t i = 0; i < CRC16_TABLE_SIZE; i++) {
+    uint16_t crc = Reflected ? uint16_t(i) : uint16_t(i << (16 - CRC16_TABLE_BITS));
+    for (size_t bit = 0; bit < CRC16_TABLE_BITS; bit++) {
+      if (Reflected) {
+        crc = (crc & 0x0001) ? uint16_t((crc >> 1) ^ CRC16_POLY_REFLECTED) : uint16_t(crc >> 1);
+      } else {
+        crc = (crc & 0x8000) ? uint16_t((crc << 1) ^ CRC16_POLY) : uint16_t(crc << 1);
+      }
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+inline constexpr std::array<uint16_t, CRC16_TABLE_SIZE> CRC16_TABLE = make_crc16_table<false>();
+inline constexpr std::array<uint16_t, CRC16_TABLE_SIZE> CRC16_TABLE_REFLECTED = make_crc16_table<true>();
+
+// 以 MSB 優先處理一個字節
+constexpr uint16_t crc16_update(uint16_t crc, uint8_t byte_val) {
+#ifdef USE_HIFLYING_LIGHT_CRC_NIBBLE_TABLE
+  crc = uint16_t(crc << 4) ^ CRC16_TABLE[((crc >> 12) ^ (byte_val >> 4)) & 0x0f];
+  crc = uint16_t(crc << 4) ^ CRC16_TABLE[((crc >> 12) ^ byte_val) & 0x0f];
+  return crc;
+#else
+  return uint16_t(crc << 8) ^ CRC16_TABLE[((crc >> 8) ^ byte_val) & 0xff];
+#endif
+}
+
+// 反射模式 (LSB 優先)，等同於對輸入與輸出各自做位反轉的 MSB 優先計算
+constexpr uint16_t crc16_update_reflected(uint16_t crc, uint8_t byte_val) {
+#ifdef USE_HIFLYING_LIGHT_CRC_NIBBLE_TABLE
+  crc = (crc >> 4) ^ CRC16_TABLE_REFLECTED[(crc ^ byte_val) & 0x0f];
+  crc = (crc >> 4) ^ CRC16_TABLE_REFLECTED[(crc ^ (byte_val >> 4)) & 0x0f];
+  return crc;
+#else
+  return (crc >> 8) ^ CRC16_TABLE_REFLECTED[(crc ^ byte_val) & 0xff];
+#endif
+}
+
+// 反轉位
+constexpr uint8_t reverse_bits(uint8_t byte_val) {
+  byte_val = uint8_t((byte_val & 0xf0) >> 4) | uint8_t((byte_val & 0x0f) << 4);
+  byte_val = uint8_t((byte_val & 0xcc) >> 2) | uint8_t((byte_val & 0x33) << 2);
+  byte_val = uint8_t((byte_val & 0xaa) >> 1) | uint8_t((byte_val & 0x55) << 1);
+  return byte_val;
+}
+
+constexpr uint16_t reverse_bits16(uint16_t value) {
+  return uint16_t(reverse_bits(value & 0xff) << 8) | reverse_bits(value >> 8);
+}
+
+// Deli16 CRC: 初始值 0xffff 經過 "cc 55 aa" 前綴後的狀態 (轉為反射模式表示)
+inline constexpr uint8_t DELI16_CRC_PREFIX[3] = {0xcc, 0x55, 0xaa};
+inline constexpr uint16_t DELI16_CRC_SEED = reverse_bits16(
+    crc16_update(crc16_update(crc16_update(0xffff, DELI16_CRC_PREFIX[0]), DELI16_CRC_PREFIX[1]), DELI16_CRC_PREFIX[2]));
+
+inline uint16_t calculate_crc16(const uint8_t *data, size_t length, uint16_t initial = 0) {
+  uint16_t crc = initial;
+  for (size_t i = 0; i < length; i++) {
+    crc = crc16_update(crc, data[i]);
+  }
+  return crc;
+}
+
+// 生成 HF 格式封包 (random_byte 由呼叫端提供，裝置上為 esp_random())
+inline Packet generate_hf_packet(const std::array<uint8_t, 5> &mac, uint8_t page, uint16_t counter, int8_t ctrl_code,
+                                 const std::array<uint8_t, 3> &params, uint8_t random_byte) {
+  // 直接在最終封包中構建，payload 位於 [4, 20)
+  Packet final_packet;
+  uint8_t *packet = final_packet.data() + 4;
+
+  packet[0] = 0xff;
+  packet[1] = random_byte;  // 隨機值
+  packet[2] = counter & 0xff;
+  packet[3] = mac[0];
+  packet[4] = mac[1] & 0xf0;  // 清除低 4 位
+  packet[5] = 0;
+  packet[6] = 0;
+  packet[7] = ctrl_code & 0xff;
+  packet[8] = page & 0xff;
+  packet[9] = 0xff;
+  packet[10] = counter & 0xff;
+  packet[11] = params[0];
+  packet[12] = params[1];
+  packet[13] = params[2];
+  
+  // 特殊處理
+  if (ctrl_code != -76) {
+    apply_encryption(packet + 9, 5, 0xaa);
+  } else {
+    packet[11] = 0xAA;
+    packet[12] = 0x66;
+    packet[13] = 0x55;
+  }
+  
+  // 計算 CRC16
+  uint16_t crc = calculate_crc16(packet, 13, 0);
+  packet[14] = crc & 0xff;
+  packet[15] = (crc >> 8) & 0xff;
+  
+  // 最終加密
+  apply_encryption(packet, 16, 86);
+
+  // 添加前綴和後綴
+  final_packet[0] = 'H';
+  final_packet[1] = 'F';
+  final_packet[2] = 'K';
+  final_packet[3] = 'J';
+  final_packet[20] = 0x10;
+  final_packet[21] = 0x11;
+  final_packet[22] = 0x12;
+  final_packet[23] = 0x13;
+  final_packet[24] = 0x14;
+  final_packet[25] = 0x15;
+  
+  return final_packet;
+}
+
+// 位操作算法 (資料白化): 7 位 LFSR 產生的密鑰流與資料逐位 XOR，與資料內容無關
+constexpr uint8_t whitening_init(uint8_t key) {
+  return uint8_t(((key & 0x02) << 4) | ((key & 0x01) << 6) | ((key & 0x20) >> 4) | 1 | ((key & 0x10) >> 2) |
+                 (key & 0x08) | ((key & 0x04) << 2));
+}
+
+// 產生一個字節的密鑰流並推進 LFSR 狀態
+constexpr uint8_t whitening_next_byte(uint8_t &state) {
+  uint8_t mask = 0;
+  for (int bit = 0; bit < 8; bit++) {
+    mask |= ((state & 0x40) >> 6) << bit;
+    state = uint8_t(state << 1);
+    uint8_t carry = (state >> 7) & 1;
+    state = (state & 0xfe) | carry;
+    state ^= carry << 4;
+  }
+  return mask;
+}
+
+template<size_t N> constexpr std::array<uint8_t, N> make_whitening_mask(uint8_t key) {
+  std::array<uint8_t, N> mask{};
+  uint8_t state = whitening_init(key);
+  for (size_t i = 0; i < N; i++) {
+    mask[i] = whitening_next_byte(state);
+  }
+  return mask;
+}
+
+// Deli16 固定使用 (63, 13) 作用於 [16, 29) 以及 (37, 29) 作用於整個緩衝區，合併成單一遮罩
+constexpr std::array<uint8_t, 29> make_deli16_whitening_mask() {
+  auto inner = make_whitening_mask<13>(63);
+  auto outer = make_whitening_mask<29>(37);
+  for (size_t i = 0; i < inner.size(); i++) {
+    outer[16 + i] ^= inner[i];
+  }
+  return outer;
+}
+
+inline constexpr std::array<uint8_t, 29> DELI16_WHITENING_MASK = make_deli16_whitening_mask();
+
+// 生成 Deli16 格式封包
+inline Packet generate_deli16_packet(const std::array<uint8_t, 5> &mac, uint8_t page, uint16_t counter,
+                                     int8_t ctrl_code, const std::array<uint8_t, 3> &params) {
+  Packet packet;
+
+  // 構建數據
+  std::array<uint8_t, 8> data;
+  data[7] = (params[0] ^ counter) & 0xff;
+  data[6] = (params[2] ^ mac[0]) & 0xff;
+  data[5] = ((mac[1] ^ params[2]) ^ counter) & 0xff;
+  
+  uint8_t temp = params[2] ^ counter;
+  data[4] = (temp ^ ctrl_code) & 0xff;
+  data[3] = (temp ^ params[1]) & 0xff;
+  data[2] = (page ^ temp) & 0xff;
+  data[1] = (temp ^ params[0]) & 0xff;
+  data[0] = (temp ^ mac[0]) & 0xff;
+  
+  // CRC 計算: 對位反轉後的數據做 MSB 優先 CRC，等同於從預先計算的前綴狀態開始的反射模式 CRC
+  uint16_t crc = DELI16_CRC_SEED;
+  for (uint8_t b : data) {
+    crc = crc16_update_reflected(crc, b);
+  }
+  uint16_t final_crc = crc ^ 0xffff;
+
+  // 構建緩衝區
+  std::array<uint8_t, 29> temp_buffer;
+  temp_buffer[13] = 0x71;
+  temp_buffer[14] = 0x0f;
+  temp_buffer[15] = 0x55;
+  std::copy(DELI16_CRC_PREFIX, DELI16_CRC_PREFIX + 3, temp_buffer.begin() + 16);
+  std::copy(data.begin(), data.end(), temp_buffer.begin() + 19);
+  
+  for (int i = 13; i < 19; i++) {
+    temp_buffer[i] = reverse_bits(temp_buffer[i]);
+  }
+  
+  temp_buffer[27] = final_crc & 0xff;
+  temp_buffer[28] = (final_crc >> 8) & 0xff;
+  
+  // 位操作處理 (預先計算的白化遮罩，只需要輸出的 [13, 29) 部分)
+  for (int i = 13; i < 29; i++) {
+    temp_buffer[i] ^= DELI16_WHITENING_MASK[i];
+  }
+
+  // 複製最終數據
+  std::copy(temp_buffer.begin() + 13, temp_buffer.begin() + 29, packet.begin());
+  
+  // 添加尾部序列
+  for (int i = 0; i < 10; i++) {
+    packet[16 + i] = (16 + i) & 0xff;
+  }
+  
+  return packet;
+}
+
+// 從遙控器或其他控制器收到的命令 (只有控制器地址的前 2 字節與計數器低 8 位會出現在封包中)
+struct DecodedCommand {
+  uint8_t address[2];  // HF 只攜帶 address[1] 的高 4 位
+  uint8_t counter;
+  int8_t ctrl_code;
+  std::array<uint8_t, 3> params;
+};
+
+// 解碼 HF 封包，CRC 或固定欄位不符時回傳 false
+inline bool decode_hf_packet(const Packet &packet, DecodedCommand &command) {
+  if (packet[0] != 'H' || packet[1] != 'F' || packet[2] != 'K' || packet[3] != 'J')
+    return false;
+
+  for (int outer = 0; outer < 16; outer++) {
+    std::array<uint8_t, 16> payload;
+    std::copy(packet.begin() + 4, packet.begin() + 20, payload.begin());
+    outer = remove_encryption(payload.data(), payload.size(), 86, outer);
+    if (outer < 0)
+      return false;
+
+    uint16_t crc = calculate_crc16(payload.data(), 13, 0);
+    if (payload[0] != 0xff || payload[14] != (crc & 0xff) || payload[15] != (crc >> 8))
+      continue;
+
+    command.address[0] = payload[3];
+    command.address[1] = payload[4];
+    command.counter = payload[2];
+    command.ctrl_code = int8_t(payload[7]);
+    if (payload[11] == 0xAA && payload[12] == 0x66 && payload[13] == 0x55 && command.ctrl_code == -76) {
+      command.params = {0, 0, 0};
+      return true;
+    }
+
+    // 內層加密: 解密後 [9] 為 0xff、[10] 為計數器
+    for (int inner = 0; inner < 16; inner++) {
+      std::array<uint8_t, 5> params;
+      std::copy(payload.begin() + 9, payload.begin() + 14, params.begin());
+      inner = remove_encryption(params.data(), params.size(), 0xaa, inner);
+      if (inner < 0)
+        break;
+      if (params[0] == 0xff && params[1] == command.counter) {
+        command.params = {params[2], params[3], params[4]};
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Deli16 封包的固定標頭 (位反轉前為 71 0f 55 cc 55 aa)
+constexpr std::array<uint8_t, 6> make_deli16_header() {
+  std::array<uint8_t, 6> header = {0x71, 0x0f, 0x55, DELI16_CRC_PREFIX[0], DELI16_CRC_PREFIX[1], DELI16_CRC_PREFIX[2]};
+  for (auto &b : header)
+    b = reverse_bits(b);
+  return header;
+}
+
+inline constexpr std::array<uint8_t, 6> DELI16_HEADER = make_deli16_header();
+
+// 解碼 Deli16 封包 (page 固定為 3)，CRC 或標頭不符時回傳 false
+inline bool decode_deli16_packet(const Packet &packet, DecodedCommand &command, uint8_t page = 3) {
+  std::array<uint8_t, 16> buffer;
+  for (int i = 0; i < 16; i++) {
+    buffer[i] = packet[i] ^ DELI16_WHITENING_MASK[13 + i];
+  }
+  for (int i = 0; i < 6; i++) {
+    if (buffer[i] != DELI16_HEADER[i])
+      return false;
+  }
+
+  const uint8_t *data = buffer.data() + 6;
+  uint16_t crc = DELI16_CRC_SEED;
+  for (int i = 0; i < 8; i++) {
+    crc = crc16_update_reflected(crc, data[i]);
+  }
+  crc ^= 0xffff;
+  if (buffer[14] != (crc & 0xff) || buffer[15] != (crc >> 8))
+    return false;
+
+  // 反推 generate_deli16_packet() 的 XOR 關係，temp = params[2] ^ counter
+  uint8_t temp = data[2] ^ page;
+  command.ctrl_code = int8_t(data[4] ^ temp);
+  command.params[1] = data[3] ^ temp;
+  command.params[0] = data[1] ^ temp;
+  command.address[0] = data[0] ^ temp;
+  command.address[1] = data[5] ^ temp;
+  command.counter = data[7] ^ command.params[0];
+  command.params[2] = temp ^ command.counter;
+  return data[6] == (command.params[2] ^ command.address[0]);
+}
+
+// 使用燈具要求的 AD 格式: 02 01 01 (Flags) + 1B 03 (16-bit Service UUID 列表) + 26 字節封包
+inline AdvFrame build_adv_frame(const Packet &packet) {
+  AdvFrame frame;
+  frame[0] = 0x02;  // Length
+  frame[1] = 0x01;  // AD Type: Flags
+  frame[2] = 0x01;  // Flags value
+  frame[3] = 0x1B;  // Length (27 bytes = 1 + 26)
+  frame[4] = 0x03;  // AD Type: Complete List of 16-bit Service Class UUIDs
+  for (size_t i = 0; i < packet.size(); i++) {
+    frame[5 + i] = packet[i];
+  }
+  return frame;
+}
+
+// 1M PHY 上一個 ADV_NONCONN_IND PDU 的空中時間 (us):
+// 前導碼 1 + 存取地址 4 + 標頭 2 + AdvA 6 + AD 資料 + CRC 3，每字節 8 us
+constexpr uint32_t adv_pdu_airtime_us(size_t adv_data_length) { return (1 + 4 + 2 + 6 + adv_data_length + 3) * 8; }
+
+// 每個廣播事件依序在 37/38/39 三個頻道各發送一次
+static const uint8_t ADV_CHANNELS = 3;
+
+// 由基礎 MAC (裝置上為 ESP32 WiFi STA MAC) 與 instance_id 推導燈具使用的 MAC
+inline std::array<uint8_t, 6> derive_device_mac(const uint8_t *base_mac, uint8_t instance_id) {
+  std::array<uint8_t, 6> device_mac;
+  // 使用基礎 MAC 的前 5 字節
+  for (int i = 0; i < 5; i++) {
+    device_mac[i] = base_mac[i];
+  }
+  // 最後一字節用 instance_id 計算
+  device_mac[5] = base_mac[5] + instance_id - 1;
+  return device_mac;
+}
+
+}  // namespace hiflying_light
+}  // namespace esphome
@@ -0,0 +1,566 @@
+#include "hiflying_radio.h"
+#include "esphome/core/log.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/esp32_ble/ble.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace esphome {
+namespace hiflying_light {
+
+static const char *const TAG = "hiflying_light.radio";
+
+HiFlyingRadio *HiFlyingRadio::get() {
+  static HiFlyingRadio radio;
+  return &radio;
+}
+
+// 裝置上預設使用傳統廣播 (dry_run 時為實際時鐘的模擬廣播器)，主機上使用虛擬時鐘的模擬廣播器
+// 第一次呼叫時 BLE 必須已經啟動 (擴展廣播在這裡設定廣播集)
+Advertiser *HiFlyingRadio::get_advertiser() {
+  if (this->advertiser_)
+    return this->advertiser_.get();
+
+#ifdef USE_ESP32
+  if (this->dry_run_) {
+    this->advertiser_ = std::make_unique<SimulatedAdvertiser>(1, false);
+    return this->advertiser_.get();
+  }
+#ifdef USE_HIFLYING_LIGHT_EXT_ADV
+  if (this->extended_advertising_) {
+    auto advertiser = std::make_unique<ExtendedAdvertiser>();
+    if (advertiser->setup()) {
+      this->advertiser_ = std::move(advertiser);
+      return this->advertiser_.get();
+    }
+    // setup() 失敗時沒有註冊 GAP 事件處理器，可以安全地銷毀
+    ESP_LOGW(TAG, "Extended advertising setup failed, falling back to legacy advertising");
+  }
+#endif
+  this->advertiser_ = std::make_unique<LegacyAdvertiser>();
+#else
+  this->advertiser_ = std::make_unique<SimulatedAdvertiser>(1, true);
+#endif
+  return this->advertiser_.get();
+}
+
+uint8_t HiFlyingRadio::pending(uint8_t lane) const {
+  return lane < TX_MAX_LANES ? this->lane_pending_[lane].load() : 0;
+}
+
+uint8_t HiFlyingRadio::pending() const { return this->pending_total_.load(); }
+
+// 待發送計數只在擁有狀態機的執行緒中透過這兩個函數改變，其他執行緒只讀取原子計數
+void HiFlyingRadio::acquire_(uint8_t lane) {
+  if (lane < TX_MAX_LANES)
+    this->lane_pending_[lane]++;
+  this->pending_total_++;
+}
+
+void HiFlyingRadio::release_(uint8_t lane) {
+  if (lane < TX_MAX_LANES)
+    this->lane_pending_[lane]--;
+  this->pending_total_--;
+}
+
+// 丟棄一個命令: 尚未發送過的命令計入通道的遺失數，並結束它在場景突發中的項目
+void HiFlyingRadio::lost_(const TxJob &job) {
+  if (job.started)
+    return;
+  if (job.lane < TX_MAX_LANES)
+    this->lane_lost_[job.lane]++;
+  this->burst_entry_done_(job.burst, 0);
+}
+
+// 狀態機內部使用的通道命令數 (只讀取自己的槽位，不含射頻任務尚未取出的命令)
+uint8_t HiFlyingRadio::lane_jobs_(uint8_t lane) const {
+  uint8_t count = 0;
+  for (const auto &job : this->jobs_) {
+    if (job.repeats_left > 0 && job.lane == lane)
+      count++;
+  }
+  return count;
+}
+
+// 找出優先級最低的命令中最舊且未在發送中的一個 (lane < 0 表示不限通道)
+int HiFlyingRadio::drop_candidate_(int lane) const {
+  int candidate = -1;
+  for (int i = 0; i < TX_POOL_SIZE; i++) {
+    const TxJob &job = this->jobs_[i];
+    if (job.repeats_left == 0 || i == this->current_)
+      continue;
+    if (lane >= 0 && job.lane != lane)
+      continue;
+    if (candidate < 0 || job.priority < this->jobs_[candidate].priority ||
+        (job.priority == this->jobs_[candidate].priority && int32_t(job.seq - this->jobs_[candidate].seq) < 0))
+      candidate = i;
+  }
+  return candidate;
+}
+
+TxJob &HiFlyingRadio::enqueue(uint8_t lane, uint8_t repeats, uint16_t interval, uint8_t priority, uint8_t group) {
+  this->acquire_(lane);
+  return this->enqueue_job_(lane, repeats, interval, priority, group);
+}
+
+// 呼叫端已經以 acquire_() 計入這個命令
+TxJob &HiFlyingRadio::enqueue_job_(uint8_t lane, uint8_t repeats, uint16_t interval, uint8_t priority,
+                                   uint8_t group) {
+  // 單一通道的待發送命令過多時丟棄該通道優先級最低的最舊命令
+  if (this->lane_jobs_(lane) >= TX_LANE_DEPTH) {
+    int drop = this->drop_candidate_(lane);
+    if (drop >= 0) {
+      ESP_LOGW(TAG, "Lane %d queue full, dropping oldest pending command", lane);
+      this->jobs_[drop].repeats_left = 0;
+      this->lost_(this->jobs_[drop]);
+      this->release_(lane);
+      this->dropped_++;
+    }
+  }
+
+  int slot = -1;
+  for (int i = 0; i < TX_POOL_SIZE; i++) {
+    if (this->jobs_[i].repeats_left == 0 && i != this->current_) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot < 0) {
+    // 槽位用盡時丟棄全域優先級最低的最舊命令
+    slot = this->drop_candidate_(-1);
+    ESP_LOGW(TAG, "Transmit pool full, dropping oldest pending command of lane %d", this->jobs_[slot].lane);
+    this->release_(this->jobs_[slot].lane);
+    this->lost_(this->jobs_[slot]);
+    this->dropped_++;
+  }
+
+  TxJob &job = this->jobs_[slot];
+  job.seq = this->next_seq_++;
+  job.queued_at = this->now_();
+  job.lane = lane;
+  job.interval = interval;
+  job.repeats_left = repeats;
+  job.priority = priority;
+  job.burst = 0;
+  job.group = group;
+  job.sent = 0;
+  job.counter = 0;
+  job.protocol = PROTOCOL_BOTH;
+  job.frame_length = UuidListFraming::LENGTH;
+  job.started = false;
+
+  // 複合命令 (例如開燈 + 亮度) 的各命令共用組內最高的優先級
+  if (group != 0) {
+    for (auto &other : this->jobs_) {
+      if (&other == &job || other.repeats_left == 0 || other.group != group)
+        continue;
+      job.priority = std::max(job.priority, other.priority);
+      other.priority = job.priority;
+    }
+  }
+  return job;
+}
+
+void HiFlyingRadio::preempt(uint8_t lane, uint8_t priority, uint32_t max_age, uint8_t group) {
+  uint32_t now = this->now_();
+  for (int i = 0; i < TX_POOL_SIZE; i++) {
+    TxJob &job = this->jobs_[i];
+    if (job.repeats_left == 0 || job.lane != lane || job.priority >= priority || (group != 0 && job.group == group))
+      continue;
+    if (job.started) {
+      // 燈具至少已收到一份，正在發送的這一次重複照常完成
+      uint8_t keep = i == this->current_ ? 1 : 0;
+      if (job.repeats_left <= keep)
+        continue;
+      ESP_LOGV(TAG, "Lane %d preempted command after %d repeats", lane, job.sent);
+      job.repeats_left = keep;
+      if (keep == 0)
+        this->release_(lane);
+    } else if (now - job.queued_at >= max_age) {
+      ESP_LOGV(TAG, "Lane %d dropped stale command queued %u ms ago", lane, now - job.queued_at);
+      job.repeats_left = 0;
+      this->release_(lane);
+      this->lost_(job);
+    } else {
+      continue;
+    }
+    this->preempted_++;
+  }
+}
+
+uint8_t HiFlyingRadio::begin_burst(size_t count) {
+  uint8_t id = this->burst_id_.load() + 1;
+  if (id == 0)
+    id = 1;
+  this->burst_start_ = this->now_();
+  this->burst_first_ = 0;
+  this->burst_remaining_.store(count);
+  this->burst_id_.store(id);
+  return id;
+}
+
+uint8_t HiFlyingRadio::begin_group() {
+  if (++this->group_id_ == 0)
+    this->group_id_ = 1;
+  return this->group_id_;
+}
+
+void HiFlyingRadio::cancel_burst_entry(uint8_t burst) { this->burst_entry_done_(burst, 0); }
+
+// 突發中的一個燈具已收到第一份封包 (now 為 0 表示該項目被取消)
+void HiFlyingRadio::burst_entry_done_(uint8_t burst, uint32_t now) {
+  if (burst == 0 || burst != this->burst_id_.load())
+    return;
+  if (now != 0 && this->burst_first_ == 0)
+    this->burst_first_ = now;
+  if (this->burst_remaining_.fetch_sub(1) != 1)
+    return;
+
+  uint32_t last = now != 0 ? now : this->now_();
+  this->last_burst_spread_ = this->burst_first_ != 0 ? last - this->burst_first_ : 0;
+  ESP_LOGI(TAG, "Scene burst complete: first to last lamp %u ms, total %u ms", this->last_burst_spread_,
+           last - this->burst_start_);
+}
+
+void HiFlyingRadio::job_done_(const TxJob &job) {
+  this->last_latency_ = this->now_() - job.queued_at;
+  if (this->last_latency_ > this->max_latency_)
+    this->max_latency_ = this->last_latency_;
+  ESP_LOGV(TAG, "Lane %d finished command in %u ms (interval: %d ms)", job.lane, this->last_latency_, job.interval);
+
+  if (this->get_advertiser()->is_simulated()) {
+    auto *sim = static_cast<SimulatedAdvertiser *>(this->advertiser_.get());
+    ESP_LOGI(TAG, "Dry run: lane %d latency %u ms, airtime %u us, %u frames (%.1f frames/s)", job.lane,
+             this->last_latency_, sim->get_airtime_us(), sim->get_frames(), sim->get_frames_per_second());
+  }
+}
+
+// 優先級最高的命令優先，其次輪詢: 從上一次發送的通道之後開始，選出第一個有待發送命令的通道中最舊的命令
+// 同一複合命令組內改選重複次數最少的命令，使各命令的重複交錯進行
+int HiFlyingRadio::pick_next_() const {
+  int best = -1;
+  uint8_t best_distance = 0;
+  for (int i = 0; i < TX_POOL_SIZE; i++) {
+    const TxJob &job = this->jobs_[i];
+    if (job.repeats_left == 0)
+      continue;
+    uint8_t distance = (job.lane + TX_MAX_LANES - this->last_lane_ - 1) % TX_MAX_LANES;
+    bool better = best < 0;
+    if (!better) {
+      const TxJob &current = this->jobs_[best];
+      if (job.priority != current.priority) {
+        better = job.priority > current.priority;
+      } else if (distance != best_distance) {
+        better = distance < best_distance;
+      } else if (job.group != 0 && job.group == current.group && job.sent != current.sent) {
+        better = job.sent < current.sent;
+      } else {
+        better = int32_t(job.seq - current.seq) < 0;
+      }
+    }
+    if (better) {
+      best = i;
+      best_distance = distance;
+    }
+  }
+  return best;
+}
+
+// 發送狀態機: IDLE -> HF -> Deli16 -> 換到下一個通道
+// 有兩個廣播集時: IDLE -> HF + Deli16 同時發送 -> 換到下一個通道
+// 只發送單一格式時: IDLE -> HF 或 Deli16 -> 換到下一個通道
+void HiFlyingRadio::loop() {
+  if (this->phase_ != TX_IDLE) {
+    TxJob &job = this->jobs_[this->current_];
+    if (this->now_() - this->phase_start_ < job.interval)
+      return;
+
+    Advertiser *advertiser = this->get_advertiser();
+    advertiser->stop(0);
+    if (this->phase_ == TX_CONCURRENT)
+      advertiser->stop(1);
+
+    if (this->phase_ == TX_HF && (job.protocol & PROTOCOL_DELI16)) {
+      // 更換另一個隨機 MAC 地址用於 Deli16 封包
+      this->start_advertising_(0, job, TRACE_DELI16);
+      this->phase_ = TX_DELI16;
+      this->phase_start_ = this->now_();
+      return;
+    }
+
+    this->phase_ = TX_IDLE;
+    this->last_lane_ = job.lane;
+    this->current_ = -1;
+    job.sent++;
+    if (--job.repeats_left == 0) {
+      this->release_(job.lane);
+      this->job_done_(job);
+    }
+  }
+
+  int next = this->pick_next_();
+  if (next < 0)
+    return;
+
+#ifdef USE_ESP32
+  if (!this->get_advertiser()->is_simulated() && !esp32_ble::global_ble->is_active()) {
+    ESP_LOGE(TAG, "BLE not active, cannot send packets");
+    for (auto &job : this->jobs_) {
+      if (job.repeats_left > 0) {
+        this->release_(job.lane);
+        this->lost_(job);
+      }
+      job.repeats_left = 0;
+    }
+    return;
+  }
+#endif
+
+  this->current_ = next;
+  TxJob &job = this->jobs_[next];
+  this->start_job_(job);
+
+  if (!job.started) {
+    job.started = true;
+    this->burst_entry_done_(job.burst, this->phase_start_);
+  }
+}
+
+void HiFlyingRadio::flush() {
+  // 射頻任務模式下狀態機屬於任務，這裡只等待所有命令發送完成
+  if (this->uses_task()) {
+    while (this->pending() > 0)
+      this->get_advertiser()->wait(1);
+    return;
+  }
+
+  while (this->phase_ != TX_IDLE || this->pending() > 0) {
+    this->loop();
+    if (this->phase_ != TX_IDLE) {
+      uint32_t elapsed = this->now_() - this->phase_start_;
+      uint16_t interval = this->jobs_[this->current_].interval;
+      this->get_advertiser()->wait(elapsed < interval ? interval - elapsed : 0);
+    }
+  }
+}
+
+void HiFlyingRadio::start_job_(TxJob &job) {
+  Advertiser *advertiser = this->get_advertiser();
+  if (job.protocol == PROTOCOL_DELI16) {
+    this->start_advertising_(0, job, TRACE_DELI16);
+    this->phase_ = TX_DELI16;
+  } else if (job.protocol == PROTOCOL_BOTH && advertiser->num_sets() > 1) {
+    // 兩個廣播集各自使用自己的隨機地址同時發送，每次重複只需一個間隔
+    this->start_advertising_(0, job, TRACE_HF);
+    this->start_advertising_(1, job, TRACE_DELI16);
+    this->phase_ = TX_CONCURRENT;
+  } else {
+    this->start_advertising_(0, job, TRACE_HF);
+    this->phase_ = TX_HF;
+  }
+  this->phase_start_ = this->now_();
+}
+
+// 在指定廣播集上開始廣播單一 AD 幀 (每次更換隨機 MAC)
+void HiFlyingRadio::start_advertising_(uint8_t set, const TxJob &job, TraceFrameType type) {
+  Advertiser *advertiser = this->get_advertiser();
+  const AdvFrame &frame = type == TRACE_HF ? job.hf_frame : job.deli16_frame;
+
+  // 每次發送前更換隨機 MAC 地址
+  uint8_t rand_addr[6];
+  for (int i = 0; i < 6; i++) {
+    rand_addr[i] = advertiser->random() & 0xFF;
+  }
+  // 確保是有效的隨機地址 (最高位需要設置為 1)
+  rand_addr[5] |= 0xC0;
+
+  advertiser->set_address(set, rand_addr);
+#ifdef USE_HIFLYING_LIGHT_TRACE
+  // 突發期間只寫入環形緩衝區，不格式化字串也不輸出日誌，避免改變發送時序
+  TraceRecord record;
+  record.time = this->now_();
+  record.counter = job.counter;
+  record.lane = job.lane;
+  record.type = type;
+  std::copy(rand_addr, rand_addr + 6, record.address);
+  record.length = job.frame_length;
+  record.payload = frame;
+  {
+    LockGuard guard(this->trace_lock_);
+    this->trace_.push(record);
+  }
+#else
+  ESP_LOGV(TAG, "Set random MAC on set %d: %02X:%02X:%02X:%02X:%02X:%02X", set,
+           rand_addr[5], rand_addr[4], rand_addr[3], rand_addr[2], rand_addr[1], rand_addr[0]);
+  ESP_LOGVV(TAG, "Sending %s packet: %s", type == TRACE_HF ? "HF" : "Deli16",
+            format_hex_pretty(frame.data(), job.frame_length).c_str());
+#endif
+
+  advertiser->set_payload(set, frame, job.frame_length);
+  advertiser->start(set);
+}
+
+#ifdef USE_HIFLYING_LIGHT_TRACE
+// 每筆記錄輸出一行註解與一行 BLE 鏈路層封包 (LINKTYPE_BLUETOOTH_LE_LL = 251):
+// 存取地址 8E89BED6 + ADV_NONCONN_IND 標頭 (TxAdd 隨機) + AdvA + AD 資料 + CRC (未計算，填 0)
+// 去掉日誌前綴後可用 text2pcap -l 251 轉成 pcap 交給 Wireshark 分析
+// 射頻任務模式下任務會同時寫入，每筆記錄在鎖內複製後才格式化，輸出期間被覆蓋的記錄略過
+void HiFlyingRadio::dump_trace() {
+  uint32_t first, end, overwritten;
+  {
+    LockGuard guard(this->trace_lock_);
+    first = this->trace_.first();
+    end = this->trace_.total();
+    overwritten = this->trace_.overwritten();
+  }
+  ESP_LOGI(TAG, "Packet trace: %u records (%u overwritten)", end - first, overwritten);
+
+  uint32_t skipped = 0;
+  for (uint32_t seq = first; seq < end; seq++) {
+    TraceRecord record;
+    bool copied;
+    {
+      LockGuard guard(this->trace_lock_);
+      copied = this->trace_.copy(seq, record);
+    }
+    if (!copied) {
+      skipped++;
+      continue;
+    }
+    const uint8_t ll_header[6] = {0xd6, 0xbe, 0x89, 0x8e, 0x42, uint8_t(6 + record.length)};
+    ESP_LOGI(TAG, "# t=%u lane=%u counter=%u %s", record.time, record.lane, record.counter,
+             record.type == TRACE_HF ? "HF" : "Deli16");
+
+    // "0000 " + 6 + 6 + 最多 31 + 3 字節，每字節 3 個字元
+    char line[8 + 46 * 3];
+    char *p = line + sprintf(line, "0000");
+    for (uint8_t b : ll_header)
+      p += sprintf(p, " %02x", b);
+    for (uint8_t b : record.address)
+      p += sprintf(p, " %02x", b);
+    for (uint8_t j = 0; j < record.length; j++)
+      p += sprintf(p, " %02x", record.payload[j]);
+    sprintf(p, " 00 00 00");
+    ESP_LOGI(TAG, "%s", line);
+  }
+  if (skipped > 0)
+    ESP_LOGI(TAG, "%u records overwritten while dumping", skipped);
+
+  // 只清除已輸出的部分，輸出期間新寫入的記錄留到下一次
+  LockGuard guard(this->trace_lock_);
+  this->trace_.clear_until(end);
+}
+#endif
+
+bool HiFlyingRadio::uses_task() const {
+#ifdef USE_ESP32
+  return this->task_handle_ != nullptr;
+#else
+  return false;
+#endif
+}
+
+bool HiFlyingRadio::submit(const RadioCommand &cmd) {
+#ifdef USE_ESP32
+  if (this->task_handle_ != nullptr) {
+    // 入隊前就計入待發送命令，呼叫端可以立即從 pending() 看到它
+    this->acquire_(cmd.lane);
+    if (!this->ring_.push(cmd)) {
+      this->release_(cmd.lane);
+      this->dropped_++;
+      return false;
+    }
+    xTaskNotifyGive(this->task_handle_);
+    return true;
+  }
+#endif
+  // 沒有射頻任務時直接在呼叫端編碼入隊
+  this->acquire_(cmd.lane);
+  this->enqueue_command_(cmd);
+  return true;
+}
+
+// 編碼一個命令記錄並入隊 (射頻任務中，或沒有任務時由 submit() 直接呼叫)
+void HiFlyingRadio::enqueue_command_(const RadioCommand &cmd) {
+  std::array<uint8_t, 5> mac;
+  std::copy(cmd.mac, cmd.mac + 5, mac.begin());
+  std::array<uint8_t, 3> params = {cmd.params[0], cmd.params[1], cmd.params[2]};
+
+#ifdef USE_HIFLYING_LIGHT_METRICS
+  uint32_t encode_start = micros();
+#endif
+  if (cmd.preempt)
+    this->preempt(cmd.lane, cmd.priority, cmd.max_age, cmd.group);
+  TxJob &job = this->enqueue_job_(cmd.lane, cmd.repeats, cmd.interval, cmd.priority, cmd.group);
+  job.burst = cmd.burst;
+  job.protocol = cmd.protocol;
+  job.counter = cmd.counter;
+  auto framing = static_cast<AdvFraming>(cmd.framing);
+  job.frame_length = adv_frame_length(framing);
+  if (cmd.protocol & PROTOCOL_HF) {
+    uint8_t random_byte = this->get_advertiser()->random() & 0xff;
+    build_adv_frame(generate_hf_packet(mac, 3, cmd.counter, cmd.ctrl_code, params, random_byte), framing,
+                    job.hf_frame);
+  }
+  if (cmd.protocol & PROTOCOL_DELI16)
+    build_adv_frame(generate_deli16_packet(mac, 3, cmd.counter, cmd.ctrl_code, params), framing, job.deli16_frame);
+#ifdef USE_HIFLYING_LIGHT_METRICS
+  this->encode_stats_.record(micros() - encode_start, cmd.protocol == PROTOCOL_BOTH ? 2 : 1);
+#endif
+}
+
+bool HiFlyingRadio::start_task() {
+#ifdef USE_ESP32
+  if (this->task_handle_ != nullptr)
+    return true;
+
+  // 將射頻任務固定在 Bluedroid 所在的核心，避免佔用 ESPHome loop 核心
+#if portNUM_PROCESSORS > 1
+#ifdef CONFIG_BT_BLUEDROID_PINNED_TO_CORE
+  const BaseType_t core = CONFIG_BT_BLUEDROID_PINNED_TO_CORE;
+#else
+  const BaseType_t core = 0;
+#endif
+#else
+  const BaseType_t core = tskNO_AFFINITY;
+#endif
+  if (xTaskCreatePinnedToCore(HiFlyingRadio::task_, "hiflying_radio", 4096, this, 5, &this->task_handle_, core) !=
+      pdPASS) {
+    this->task_handle_ = nullptr;
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+#ifdef USE_ESP32
+// 射頻任務: 取出命令記錄後完成封包編碼並推進發送狀態機，沒有工作時休眠等待通知
+void HiFlyingRadio::task_(void *arg) {
+  auto *self = static_cast<HiFlyingRadio *>(arg);
+  RadioCommand cmd;
+
+  while (true) {
+    while (self->ring_.pop(cmd))
+      self->enqueue_command_(cmd);
+
+    self->loop();
+
+    TickType_t wait = portMAX_DELAY;
+    if (self->phase_ != TX_IDLE) {
+      uint32_t elapsed = self->now_() - self->phase_start_;
+      uint16_t interval = self->jobs_[self->current_].interval;
+      wait = pdMS_TO_TICKS(elapsed < interval ? interval - elapsed : 0);
+      if (wait == 0)
+        wait = 1;
+    }
+    ulTaskNotifyTake(pdTRUE, wait);
+  }
+}
+#endif
+
+}  // namespace hiflying_light
+}  // namespace esphome
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "hiflying_protocol.h"
+#include "hiflying_framing.h"
+#include "hiflying_advertiser.h"
+#include "hiflying_trace.h"
+#include "esphome/core/helpers.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace esphome {
+namespace hiflying_light {
+
+// 發送狀態機階段
+enum TxPhase : uint8_t {
+  TX_IDLE = 0,
+  TX_HF,
+  TX_DELI16,
+  TX_CONCURRENT,  // HF 與 Deli16 在兩個廣播集上同時發送
+};
+
+// 燈具解碼的封包格式 (位元遮罩，AUTO 表示從 preferences 讀取探測結果)
+enum HiFlyingProtocol : uint8_t {
+  PROTOCOL_AUTO = 0,
+  PROTOCOL_HF = 1 << 0,
+  PROTOCOL_DELI16 = 1 << 1,
+  PROTOCOL_BOTH = PROTOCOL_HF | PROTOCOL_DELI16,
+};
+
+// 待發送的命令 (一組 HF + Deli16 AD 幀與剩餘重複次數)
+// repeats_left 為 0 表示槽位空閒
+struct TxJob {
+  AdvFrame hf_frame;
+  AdvFrame deli16_frame;
+  uint32_t seq{0};        // 入隊順序，同一通道內先進先出
+  uint32_t queued_at{0};  // 入隊時間 (仲裁器時鐘)，用於統計命令延遲
+  uint16_t interval{10};  // 每個廣播步驟的時間 (ms)
+  uint16_t counter{0};    // 封包計數器 (只用於追蹤)
+  uint8_t lane{0};        // 通道 (instance_id)
+  uint8_t repeats_left{0};
+  uint8_t priority{0};    // 優先發送；佇列已滿時先丟棄優先級較低的命令
+  uint8_t burst{0};       // 所屬場景突發 (0 表示不屬於任何突發)
+  uint8_t group{0};       // 複合命令 (0 表示單一命令)，同一組的命令在通道內交錯重複
+  uint8_t sent{0};        // 已完成的重複次數
+  uint8_t protocol{PROTOCOL_BOTH};  // 只發送燈具能解碼的幀
+  uint8_t frame_length{UuidListFraming::LENGTH};  // 兩個幀使用相同的封裝策略
+  bool started{false};    // 是否已發送第一份
+};
+
+static const uint8_t TX_POOL_SIZE = 16;
+static const uint8_t TX_LANE_DEPTH = 8;
+static const uint8_t TX_MAX_LANES = 100;
+
+// 交給射頻任務的命令記錄 (POD，不含任何動態配置)
+struct RadioCommand {
+  uint8_t mac[5];
+  uint16_t counter;
+  int8_t ctrl_code;
+  uint8_t params[3];
+  uint8_t lane;
+  uint8_t repeats;
+  uint16_t interval;
+  uint8_t priority;
+  uint8_t burst;
+  uint8_t group;
+  uint8_t protocol;
+  uint8_t framing;
+  bool preempt;      // 入隊前以 priority 與 max_age 呼叫 preempt()
+  uint16_t max_age;
+};
+
+static const uint8_t RADIO_RING_SIZE = 16;
+
+// 封包編碼時間統計 (USE_HIFLYING_LIGHT_METRICS 時才計時)
+// 直方圖以 2 的次方分桶: <16 us, <32 us, ..., >= 1024 us
+static const uint8_t ENCODE_HISTOGRAM_BUCKETS = 8;
+
+struct EncodeStats {
+  uint32_t frames{0};
+  uint32_t total_us{0};
+  uint32_t max_us{0};
+  std::array<uint32_t, ENCODE_HISTOGRAM_BUCKETS> histogram{};
+
+  // 記錄一次編碼 (us 為 frames 個 AD 幀的總時間)
+  void record(uint32_t us, uint8_t count) {
+    if (count == 0)
+      return;
+    uint32_t per_frame = us / count;
+    this->frames += count;
+    this->total_us += us;
+    if (per_frame > this->max_us)
+      this->max_us = per_frame;
+    uint8_t bucket = 0;
+    for (uint32_t limit = 16; bucket < ENCODE_HISTOGRAM_BUCKETS - 1 && per_frame >= limit; limit <<= 1)
+      bucket++;
+    this->histogram[bucket] += count;
+  }
+};
+
+// 單生產者/單消費者無鎖環形緩衝區 (生產者: ESPHome loop, 消費者: 射頻任務)
+template<typename T, uint8_t N> class SpscRing {
+ public:
+  bool push(const T &item) {
+    uint8_t head = this->head_.load(std::memory_order_relaxed);
+    uint8_t next = (head + 1) % N;
+    if (next == this->tail_.load(std::memory_order_acquire))
+      return false;
+    this->items_[head] = item;
+    this->head_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T &item) {
+    uint8_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (tail == this->head_.load(std::memory_order_acquire))
+      return false;
+    item = this->items_[tail];
+    this->tail_.store((tail + 1) % N, std::memory_order_release);
+    return true;
+  }
+
+ protected:
+  T items_[N];
+  std::atomic<uint8_t> head_{0};
+  std::atomic<uint8_t> tail_{0};
+};
+
+// 全域射頻仲裁器: 唯一擁有廣播器的物件
+// 所有實例的命令依通道 (instance_id) 輪詢發送，每次只發送一輪重複後即換到下一個通道，
+// 因此有 N 個活躍通道時，每個通道最多等待 N - 1 輪即可得到下一次發送
+// 優先級較高的命令不參與輪詢，目前這一輪結束後立即發送
+class HiFlyingRadio {
+ public:
+  static HiFlyingRadio *get();
+
+  // 使用 BLE 5 擴展廣播 (兩個廣播集同時發送 HF 與 Deli16)，失敗時退回傳統廣播
+  void set_extended_advertising(bool extended) { this->extended_advertising_ = extended; }
+  // 不使用射頻，改用模擬廣播器記錄幀與空中時間 (dry_run)
+  // 廣播器在第一次 get_advertiser() 時建立，這兩個選項必須在任何元件 setup() 之前設定
+  void set_dry_run(bool dry_run) { this->dry_run_ = dry_run; }
+  bool is_dry_run() const { return this->dry_run_; }
+  Advertiser *get_advertiser();
+
+  // 取得一個發送槽位，呼叫端負責填入 AD 幀
+  // group 不為 0 時同一組的命令使用組內最高的優先級，交錯發送不會被優先級打斷
+  TxJob &enqueue(uint8_t lane, uint8_t repeats, uint16_t interval, uint8_t priority = 0, uint8_t group = 0);
+  // 搶佔: 在高優先級命令入隊前取消同一通道中優先級較低的命令 (同一組的命令除外)
+  // 已發送過的命令放棄剩餘重複，尚未發送且已等待 max_age ms 以上的命令直接丟棄 (0 表示全部丟棄)
+  void preempt(uint8_t lane, uint8_t priority, uint32_t max_age, uint8_t group = 0);
+  // 射頻任務模式: 只推入命令記錄，由任務編碼後入隊 (沒有任務時立即編碼入隊)
+  bool submit(const RadioCommand &cmd);
+
+  // 推進發送狀態機 (非任務模式下由各實例的 loop() 呼叫，多次呼叫無副作用)
+  void loop();
+  // 阻塞直到所有待發送命令完成 (blocking 模式，射頻任務模式下只等待不推進狀態機)
+  void flush();
+
+  // 場景突發: 記錄從開始到每個燈具收到第一份封包的時間
+  uint8_t begin_burst(size_t count);
+  void cancel_burst_entry(uint8_t burst);
+  uint32_t get_last_burst_spread() const { return this->last_burst_spread_; }
+
+  // 複合命令: 同一通道、同一組的命令輪流發送，每個命令的第一份在第一輪內全部送出
+  uint8_t begin_group();
+
+  // 命令延遲: 從入隊到最後一次重複發送完成
+  uint32_t get_last_latency() const { return this->last_latency_; }
+  uint32_t get_max_latency() const { return this->max_latency_; }
+
+  bool start_task();
+  bool uses_task() const;
+
+  // 已入隊 (包括射頻任務尚未取出的) 且尚未發送完成的命令數，可以在任何執行緒讀取
+  uint8_t pending(uint8_t lane) const;
+  uint8_t pending() const;
+
+  // 因佇列已滿而丟棄的命令總數
+  uint32_t get_dropped() const { return this->dropped_.load(); }
+  // 因搶佔而縮短或丟棄的命令總數
+  uint32_t get_preempted() const { return this->preempted_.load(); }
+  // 通道中一份都沒有發送就被丟棄的命令數 (只用於偵測變化，會迴繞)
+  // 呼叫端入隊時已更新狀態快取，數值改變表示快取中可能有燈具從未收到的值
+  uint8_t get_lost(uint8_t lane) const { return lane < TX_MAX_LANES ? this->lane_lost_[lane].load() : 0; }
+  EncodeStats &get_encode_stats() { return this->encode_stats_; }
+
+#ifdef USE_HIFLYING_LIGHT_TRACE
+  // 以 text2pcap 可讀的十六進位格式輸出追蹤記錄 (BLE 鏈路層封包)，之後清空
+  void dump_trace();
+#endif
+
+ protected:
+  TxJob &enqueue_job_(uint8_t lane, uint8_t repeats, uint16_t interval, uint8_t priority, uint8_t group);
+  void enqueue_command_(const RadioCommand &cmd);
+  void acquire_(uint8_t lane);
+  void release_(uint8_t lane);
+  void lost_(const TxJob &job);
+  uint8_t lane_jobs_(uint8_t lane) const;
+  int pick_next_() const;
+  int drop_candidate_(int lane) const;
+  void start_advertising_(uint8_t set, const TxJob &job, TraceFrameType type);
+  void start_job_(TxJob &job);
+  void burst_entry_done_(uint8_t burst, uint32_t now);
+  void job_done_(const TxJob &job);
+  uint32_t now_() { return this->get_advertiser()->now(); }
+
+  std::unique_ptr<Advertiser> advertiser_;
+  bool dry_run_{false};
+  bool extended_advertising_{false};
+  std::array<TxJob, TX_POOL_SIZE> jobs_{};
+  uint32_t next_seq_{1};
+  uint8_t last_lane_{0};
+  int current_{-1};
+  TxPhase phase_{TX_IDLE};
+  uint32_t phase_start_{0};
+
+  // 突發統計可能在射頻任務中更新，因此使用原子變數
+  std::atomic<uint8_t> burst_id_{0};
+  uint8_t group_id_{0};
+  std::atomic<int> burst_remaining_{0};
+  uint32_t burst_start_{0};
+  uint32_t burst_first_{0};
+  uint32_t last_burst_spread_{0};
+  uint32_t last_latency_{0};
+  uint32_t max_latency_{0};
+  // 以下計數可能由射頻任務更新並由 ESPHome loop 讀取
+  std::array<std::atomic<uint8_t>, TX_MAX_LANES> lane_pending_{};
+  std::atomic<uint8_t> pending_total_{0};
+  std::array<std::atomic<uint8_t>, TX_MAX_LANES> lane_lost_{};
+  std::atomic<uint32_t> dropped_{0};
+  std::atomic<uint32_t> preempted_{0};
+  EncodeStats encode_stats_;
+#ifdef USE_HIFLYING_LIGHT_TRACE
+  PacketTrace<TRACE_SIZE> trace_;
+  Mutex trace_lock_;  // 射頻任務寫入、ESPHome loop 輸出
+#endif
+
+  SpscRing<RadioCommand, RADIO_RING_SIZE> ring_;
+#ifdef USE_ESP32
+  TaskHandle_t task_handle_{nullptr};
+  static void task_(void *arg);
+#endif
+};
+
+}  // namespace hiflying_light
+}  // namespace esphome
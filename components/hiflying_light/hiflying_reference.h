@@ -0,0 +1,299 @@
+#pragma once
+
+// 參考實現: 凍結自最初的逐位元編碼器 (TEA、加密、CRC16、位反轉、資料白化)，只用於差分驗證
+// 與原始程式碼相比只有兩處改動，其餘逐行相同，請勿優化:
+// - esp_random() 改為參數注入
+// - tea_encrypt 的 data[3] << 24 與 data[7] << 24 改為 uint32_t(...) << 24 (int 左移進位到符號位元是未定義行為，
+//   在 GCC/Clang 上結果相同)
+// 僅依賴標準函式庫，可在 Linux 主機上獨立編譯
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace hiflying_light {
+namespace reference {
+
+// TEA 加密實現
+inline std::array<uint8_t, 8> tea_encrypt(const std::array<uint8_t, 8> &data) {
+  const char key[] = "!hIflIngCypcal@#";
+
+  uint32_t v0 = (data[0]) | (data[1] << 8) | (data[2] << 16) | (uint32_t(data[3]) << 24);
+  uint32_t v1 = (data[4]) | (data[5] << 8) | (data[6] << 16) | (uint32_t(data[7]) << 24);
+
+  uint32_t k0 = (key[0]) | (key[1] << 8) | (key[2] << 16) | (key[3] << 24);
+  uint32_t k1 = (key[4]) | (key[5] << 8) | (key[6] << 16) | (key[7] << 24);
+  uint32_t k2 = (key[8]) | (key[9] << 8) | (key[10] << 16) | (key[11] << 24);
+  uint32_t k3 = (key[12]) | (key[13] << 8) | (key[14] << 16) | (key[15] << 24);
+
+  uint32_t delta = 0x9e3779b9;
+  uint32_t sum_val = 0xc6ef3720;
+
+  for (int i = 0; i < 32; i++) {
+    v1 = (v1 - (((v0 << 4) + k2) ^ (v0 + sum_val) ^ ((v0 >> 5) + k3))) & 0xffffffff;
+    v0 = (v0 - (((v1 << 4) + k0) ^ (v1 + sum_val) ^ ((v1 >> 5) + k1))) & 0xffffffff;
+    sum_val = (sum_val - delta) & 0xffffffff;
+  }
+
+  std::array<uint8_t, 8> result;
+  result[0] = v0 & 0xff;
+  result[1] = (v0 >> 8) & 0xff;
+  result[2] = (v0 >> 16) & 0xff;
+  result[3] = (v0 >> 24) & 0xff;
+  result[4] = v1 & 0xff;
+  result[5] = (v1 >> 8) & 0xff;
+  result[6] = (v1 >> 16) & 0xff;
+  result[7] = (v1 >> 24) & 0xff;
+
+  return result;
+}
+
+// 獲取加密表
+inline std::array<uint8_t, 16> get_encryption_table() {
+  const std::array<uint8_t, 16> base_key = {
+    0x52, 0xea, 0x73, 0xff, 0x49, 0x60, 0xbf, 0x56,
+    0x42, 0x05, 0x07, 0xe8, 0xd3, 0xa7, 0xb9, 0x9d
+  };
+
+  std::array<uint8_t, 16> table;
+
+  std::array<uint8_t, 8> part1;
+  std::copy(base_key.begin(), base_key.begin() + 8, part1.begin());
+  auto encrypted1 = tea_encrypt(part1);
+  std::copy(encrypted1.begin(), encrypted1.end(), table.begin());
+
+  std::array<uint8_t, 8> part2;
+  std::copy(base_key.begin() + 8, base_key.end(), part2.begin());
+  auto encrypted2 = tea_encrypt(part2);
+  std::copy(encrypted2.begin(), encrypted2.end(), table.begin() + 8);
+
+  return table;
+}
+
+// 應用加密
+inline void apply_encryption(std::vector<uint8_t> &data, size_t start, size_t length, uint8_t key) {
+  auto enc_table = get_encryption_table();
+
+  if (start + 1 < data.size()) {
+    uint8_t b = data[start + 1];
+    uint8_t i = b & 0x0f;
+    b = enc_table[((b >> 4) & 0x0f) ^ i];
+
+    for (size_t j = 0; j < length; j++) {
+      if (start + j < data.size()) {
+        size_t pos = start + j;
+        uint8_t i2 = data[pos] ^ b;
+        uint8_t i3 = (j + key) & 0x0f;
+        data[pos] = ((i2 & 0xff) + enc_table[i3 & 0xff]) & 0xff;
+      }
+    }
+  }
+}
+
+// CRC16 計算
+inline uint16_t calculate_crc16(const std::vector<uint8_t> &data, size_t start, size_t length, uint16_t initial) {
+  uint16_t crc = initial;
+  uint16_t poly = 0x1021;
+
+  for (size_t i = 0; i < length && (start + i) < data.size(); i++) {
+    uint8_t byte_val = data[start + i];
+    crc ^= (byte_val << 8);
+
+    for (int j = 0; j < 8; j++) {
+      if (crc & 0x8000) {
+        crc = ((crc << 1) ^ poly) & 0xffff;
+      } else {
+        crc = (crc << 1) & 0xffff;
+      }
+    }
+  }
+
+  return crc;
+}
+
+// 反轉位
+inline uint8_t reverse_bits(uint8_t byte_val) {
+  uint8_t result = 0;
+  for (int i = 0; i < 8; i++) {
+    if (byte_val & (1 << i)) {
+      result |= (1 << (7 - i));
+    }
+  }
+  return result;
+}
+
+// 生成 HF 格式封包
+inline std::vector<uint8_t> generate_hf_packet(const std::array<uint8_t, 5> &mac, uint8_t page, uint16_t counter,
+                                               int8_t ctrl_code, const std::array<uint8_t, 3> &params,
+                                               uint8_t random_byte) {
+  std::vector<uint8_t> packet(16);
+
+  packet[0] = 0xff;
+  packet[1] = random_byte;  // 隨機值
+  packet[2] = counter & 0xff;
+  packet[3] = mac[0];
+  packet[4] = mac[1] & 0xf0;  // 清除低 4 位
+  packet[5] = 0;
+  packet[6] = 0;
+  packet[7] = ctrl_code & 0xff;
+  packet[8] = page & 0xff;
+  packet[9] = 0xff;
+  packet[10] = counter & 0xff;
+  packet[11] = params[0];
+  packet[12] = params[1];
+  packet[13] = params[2];
+
+  // 特殊處理
+  if (ctrl_code != -76) {
+    apply_encryption(packet, 9, 5, 0xaa);
+  } else {
+    packet[11] = 0xAA;
+    packet[12] = 0x66;
+    packet[13] = 0x55;
+  }
+
+  // 計算 CRC16
+  uint16_t crc = calculate_crc16(packet, 0, 13, 0);
+  packet[14] = crc & 0xff;
+  packet[15] = (crc >> 8) & 0xff;
+
+  // 最終加密
+  apply_encryption(packet, 0, 16, 86);
+
+  // 添加前綴和後綴
+  std::vector<uint8_t> final_packet(26);
+  final_packet[0] = 'H';
+  final_packet[1] = 'F';
+  final_packet[2] = 'K';
+  final_packet[3] = 'J';
+  std::copy(packet.begin(), packet.end(), final_packet.begin() + 4);
+  final_packet[20] = 0x10;
+  final_packet[21] = 0x11;
+  final_packet[22] = 0x12;
+  final_packet[23] = 0x13;
+  final_packet[24] = 0x14;
+  final_packet[25] = 0x15;
+
+  return final_packet;
+}
+
+// 位操作算法
+inline void apply_bit_operation(std::vector<uint8_t> &data, size_t length, uint8_t key) {
+  uint8_t processed_key = ((key & 0x02) << 4) | ((((((((key & 0x01) << 6) |
+                         ((key & 0x20) >> 4)) | 1) | ((key & 0x10) >> 2)) |
+                         (key & 0x08)) | ((key & 0x04) << 2)) & 0xff);
+
+  for (size_t i = 0; i < length && i < data.size(); i++) {
+    uint8_t new_byte = 0;
+    for (int bit = 0; bit < 8; bit++) {
+      processed_key &= 0xff;
+      uint8_t bit_val = (processed_key & 0x40) >> 6;
+      bit_val = bit_val << bit;
+      bit_val ^= (data[i] & 0xff);
+      bit_val &= (1 << bit);
+      new_byte |= bit_val;
+
+      processed_key <<= 1;
+      uint8_t carry = (processed_key >> 7) & 1;
+      processed_key &= 0xfe;
+      processed_key |= carry;
+
+      uint8_t xor_val = carry << 4;
+      xor_val ^= processed_key;
+      xor_val &= 0x10;
+      processed_key &= 0xef;
+      processed_key |= xor_val;
+    }
+    data[i] = new_byte;
+  }
+}
+
+// 生成 Deli16 格式封包
+inline std::vector<uint8_t> generate_deli16_packet(const std::array<uint8_t, 5> &mac, uint8_t page, uint16_t counter,
+                                                   int8_t ctrl_code, const std::array<uint8_t, 3> &params) {
+  std::vector<uint8_t> packet(26);
+
+  // 構建數據
+  std::vector<uint8_t> data(8);
+  data[7] = (params[0] ^ counter) & 0xff;
+  data[6] = (params[2] ^ mac[0]) & 0xff;
+  data[5] = ((mac[1] ^ params[2]) ^ counter) & 0xff;
+
+  uint8_t temp = params[2] ^ counter;
+  data[4] = (temp ^ ctrl_code) & 0xff;
+  data[3] = (temp ^ params[1]) & 0xff;
+  data[2] = (page ^ temp) & 0xff;
+  data[1] = (temp ^ params[0]) & 0xff;
+  data[0] = (temp ^ mac[0]) & 0xff;
+
+  // CRC 計算
+  std::vector<uint8_t> crc_prefix = {0xcc, 0x55, 0xaa};
+  uint16_t crc = 0xffff;
+
+  for (uint8_t b : crc_prefix) {
+    crc ^= (b << 8);
+    for (int i = 0; i < 8; i++) {
+      if (crc & 0x8000) {
+        crc = ((crc << 1) ^ 0x1021) & 0xffff;
+      } else {
+        crc = (crc << 1) & 0xffff;
+      }
+    }
+  }
+
+  for (uint8_t b : data) {
+    uint8_t reversed_b = reverse_bits(b);
+    crc ^= (reversed_b << 8);
+    for (int i = 0; i < 8; i++) {
+      if (crc & 0x8000) {
+        crc = ((crc << 1) ^ 0x1021) & 0xffff;
+      } else {
+        crc = (crc << 1) & 0xffff;
+      }
+    }
+  }
+
+  uint16_t final_crc = crc ^ 0xffff;
+  final_crc = ((reverse_bits(final_crc & 0xff) << 8) |
+               reverse_bits((final_crc >> 8) & 0xff)) & 0xffff;
+
+  // 構建緩衝區
+  std::vector<uint8_t> temp_buffer(29);
+  temp_buffer[13] = 0x71;
+  temp_buffer[14] = 0x0f;
+  temp_buffer[15] = 0x55;
+  std::copy(crc_prefix.begin(), crc_prefix.end(), temp_buffer.begin() + 16);
+  std::copy(data.begin(), data.end(), temp_buffer.begin() + 19);
+
+  for (int i = 13; i < 19; i++) {
+    temp_buffer[i] = reverse_bits(temp_buffer[i]);
+  }
+
+  temp_buffer[27] = final_crc & 0xff;
+  temp_buffer[28] = (final_crc >> 8) & 0xff;
+
+  // 位操作處理
+  std::vector<uint8_t> mid_buffer(13);
+  std::copy(temp_buffer.begin() + 16, temp_buffer.begin() + 29, mid_buffer.begin());
+  apply_bit_operation(mid_buffer, 13, 63);
+  std::copy(mid_buffer.begin(), mid_buffer.end(), temp_buffer.begin() + 16);
+
+  apply_bit_operation(temp_buffer, 29, 37);
+
+  // 複製最終數據
+  std::copy(temp_buffer.begin() + 13, temp_buffer.begin() + 29, packet.begin());
+
+  // 添加尾部序列
+  for (int i = 0; i < 10; i++) {
+    packet[16 + i] = (16 + i) & 0xff;
+  }
+
+  return packet;
+}
+
+}  // namespace reference
+}  // namespace hiflying_light
+}  // namespace esphome
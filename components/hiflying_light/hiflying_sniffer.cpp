@@ -0,0 +1,59 @@
+#include "hiflying_sniffer.h"
+
+#ifdef USE_HIFLYING_LIGHT_SNIFFER
+
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace hiflying_light {
+
+static const char *const TAG = "hiflying_light.sniffer";
+
+// 26 字節封包在 AD 幀中是一個 16-bit Service UUID 列表 (13 個 UUID，小端序)
+bool HiFlyingLightSniffer::parse_device(const esp32_ble_tracker::ESPBTDevice &device) {
+  const auto &uuids = device.get_service_uuids();
+  if (uuids.size() != 13)
+    return false;
+
+  Packet packet;
+  for (size_t i = 0; i < uuids.size(); i++) {
+    auto uuid = uuids[i].get_uuid();
+    if (uuid.len != ESP_UUID_LEN_16)
+      return false;
+    packet[2 * i] = uuid.uuid.uuid16 & 0xff;
+    packet[2 * i + 1] = uuid.uuid.uuid16 >> 8;
+  }
+
+  DecodedCommand command;
+  bool hf = decode_hf_packet(packet, command);
+  if (!hf && !decode_deli16_packet(packet, command))
+    return false;
+
+  if (command.counter == this->last_counter_ && command.ctrl_code == this->last_ctrl_code_)
+    return true;
+  this->last_counter_ = command.counter;
+  this->last_ctrl_code_ = command.ctrl_code;
+
+  uint16_t param = (uint16_t(command.params[1]) << 8) | command.params[2];
+  ESP_LOGD(TAG, "Sniffed %s command %d param %d from %02X%02X (counter: %d)", hf ? "HF" : "Deli16",
+           command.ctrl_code, param, command.address[0], command.address[1], command.counter);
+
+  HiFlyingCommand decoded;
+  if (!this->matches_(command, hf) || !HiFlyingLightComponent::command_from_ctrl_code(command.ctrl_code, decoded))
+    return true;
+
+  this->parent_->update_cache(decoded, param);
+  return true;
+}
+
+// HF 只攜帶地址第 2 字節的高 4 位
+bool HiFlyingLightSniffer::matches_(const DecodedCommand &command, bool hf) const {
+  const uint8_t expected[2] = {uint8_t(this->remote_address_ >> 8), uint8_t(this->remote_address_ & 0xff)};
+  uint8_t mask = hf ? 0xf0 : 0xff;
+  return command.address[0] == expected[0] && (command.address[1] & mask) == (expected[1] & mask);
+}
+
+}  // namespace hiflying_light
+}  // namespace esphome
+
+#endif  // USE_HIFLYING_LIGHT_SNIFFER
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_HIFLYING_LIGHT_SNIFFER
+
+#include "esphome/components/esp32_ble_tracker/esp32_ble_tracker.h"
+#include "hiflying_light.h"
+
+namespace esphome {
+namespace hiflying_light {
+
+// 被動監聽實體遙控器 (或其他控制器) 發出的 HF/Deli16 廣播，解碼後更新燈具的狀態快取，
+// 之後相同的命令就不會再由 ESP32 重複發送
+class HiFlyingLightSniffer : public esp32_ble_tracker::ESPBTDeviceListener {
+ public:
+  explicit HiFlyingLightSniffer(HiFlyingLightComponent *parent) : parent_(parent) {}
+
+  // 遙控器地址的前 2 字節 (必須設定: 本組件自己發送的命令不需要監聽，其他控制器的命令不屬於這個燈具)
+  void set_remote_address(uint16_t address) { this->remote_address_ = address; }
+
+  bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
+
+ protected:
+  bool matches_(const DecodedCommand &command, bool hf) const;
+
+  HiFlyingLightComponent *parent_;
+  uint16_t remote_address_{0};
+
+  // 遙控器每個命令會重複發送多次，以計數器與 ctrl_code 去重
+  int16_t last_counter_{-1};
+  int8_t last_ctrl_code_{0};
+};
+
+}  // namespace hiflying_light
+}  // namespace esphome
+
+#endif  // USE_HIFLYING_LIGHT_SNIFFER
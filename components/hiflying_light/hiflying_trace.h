@@ -0,0 +1,71 @@
+#pragma once
+
+// 發送路徑的二進位封包追蹤: 固定大小的環形緩衝區，寫入時不配置記憶體也不產生日誌，
+// 需要時才一次輸出 (見 HiFlyingRadio::dump_trace())
+
+#include "hiflying_protocol.h"
+
+#include <array>
+#include <cstdint>
+
+namespace esphome {
+namespace hiflying_light {
+
+enum TraceFrameType : uint8_t {
+  TRACE_HF = 0,
+  TRACE_DELI16,
+};
+
+// 一次廣播開始 (每個廣播集、每次重複各一筆)
+struct TraceRecord {
+  uint32_t time;        // 仲裁器時鐘 (ms)
+  uint16_t counter;
+  uint8_t lane;         // instance_id
+  uint8_t type;         // TraceFrameType
+  uint8_t address[6];   // 本次使用的隨機地址
+  uint8_t length;       // AD 資料長度 (依封裝策略)
+  AdvFrame payload;
+};
+
+static const uint8_t TRACE_SIZE = 64;
+
+// 滿了之後覆蓋最舊的記錄。每筆記錄以寫入序號 (0 起算) 識別，本身不做同步，
+// 寫入者 (發送狀態機) 與讀取者 (dump_trace) 在不同執行緒時由呼叫端加鎖
+template<uint8_t N> class PacketTrace {
+ public:
+  void push(const TraceRecord &record) {
+    this->records_[this->total_ % N] = record;
+    this->total_++;
+  }
+
+  // 仍保存在緩衝區中且未清除的最舊序號，與總寫入數 (下一筆的序號)
+  uint32_t first() const {
+    uint32_t oldest = this->total_ > N ? this->total_ - N : 0;
+    return oldest > this->start_ ? oldest : this->start_;
+  }
+  uint32_t total() const { return this->total_; }
+  // 上一次清除後寫入、但已被覆蓋的記錄數
+  uint32_t overwritten() const { return this->first() - this->start_; }
+
+  // 複製序號 seq 的記錄，已被覆蓋或清除時回傳 false
+  bool copy(uint32_t seq, TraceRecord &record) const {
+    if (seq < this->first() || seq >= this->total_)
+      return false;
+    record = this->records_[seq % N];
+    return true;
+  }
+
+  // 清除序號 seq 之前的記錄 (之後寫入的保留)
+  void clear_until(uint32_t seq) {
+    if (seq > this->start_)
+      this->start_ = seq;
+  }
+
+ protected:
+  std::array<TraceRecord, N> records_{};
+  uint32_t total_{0};
+  uint32_t start_{0};
+};
+
+}  // namespace hiflying_light
+}  // namespace esphome
@@ -3,27 +3,75 @@ import esphome.config_validation as cv
 from esphome.components import light
 from esphome.const import CONF_OUTPUT_ID
 
-from . import HiFlyingLightComponent, hiflying_light_ns
+from . import (
+    CONF_INSTANCE_ID,
+    CONF_PROTOCOL,
+    HiFlyingLightComponent,
+    HiFlyingLightHub,
+    HiFlyingProtocol,
+    hiflying_light_ns,
+)
+
+CONF_HIFLYING_LIGHT_ID = "hiflying_light_id"
+CONF_HUB_ID = "hub_id"
 
 HiFlyingLightOutput = hiflying_light_ns.class_(
     "HiFlyingLightOutput", light.LightOutput
 )
+HiFlyingHubLightOutput = hiflying_light_ns.class_(
+    "HiFlyingHubLightOutput", light.LightOutput
+)
+
+# 集線器燈具沒有探測流程，格式需明確指定
+HUB_PROTOCOLS = {
+    "hf": HiFlyingProtocol.PROTOCOL_HF,
+    "deli16": HiFlyingProtocol.PROTOCOL_DELI16,
+    "both": HiFlyingProtocol.PROTOCOL_BOTH,
+}
+
+
+def _validate_hub_lamp(config):
+    if CONF_HUB_ID in config and CONF_INSTANCE_ID not in config:
+        raise cv.Invalid(f"{CONF_INSTANCE_ID} is required with {CONF_HUB_ID}")
+    if CONF_HUB_ID not in config and (
+        CONF_INSTANCE_ID in config or CONF_PROTOCOL in config
+    ):
+        raise cv.Invalid(
+            f"{CONF_INSTANCE_ID} and {CONF_PROTOCOL} are only used with {CONF_HUB_ID}"
+        )
+    return config
+
 
-CONFIG_SCHEMA = light.BRIGHTNESS_ONLY_LIGHT_SCHEMA.extend(
-    {
-        cv.GenerateID(CONF_OUTPUT_ID): cv.declare_id(HiFlyingLightOutput),
-        cv.Required("hiflying_light_id"): cv.use_id(HiFlyingLightComponent),
-        cv.Optional("color_temperature", default=False): cv.boolean,
-    }
+# hiflying_light_id: 獨立元件; hub_id + instance_id: 集線器中的一個燈具
+CONFIG_SCHEMA = cv.All(
+    light.BRIGHTNESS_ONLY_LIGHT_SCHEMA.extend(
+        {
+            cv.GenerateID(CONF_OUTPUT_ID): cv.declare_id(HiFlyingLightOutput),
+            cv.Optional(CONF_HIFLYING_LIGHT_ID): cv.use_id(HiFlyingLightComponent),
+            cv.Optional(CONF_HUB_ID): cv.use_id(HiFlyingLightHub),
+            cv.Optional(CONF_INSTANCE_ID): cv.int_range(min=1, max=99),
+            cv.Optional(CONF_PROTOCOL): cv.enum(HUB_PROTOCOLS, lower=True),
+            cv.Optional("color_temperature", default=False): cv.boolean,
+        }
+    ),
+    cv.has_exactly_one_key(CONF_HIFLYING_LIGHT_ID, CONF_HUB_ID),
+    _validate_hub_lamp,
 )
 
 
 async def to_code(config):
+    if CONF_HUB_ID in config:
+        config[CONF_OUTPUT_ID].type = HiFlyingHubLightOutput
     var = cg.new_Pvariable(config[CONF_OUTPUT_ID])
     await light.register_light(var, config)
 
-    parent = await cg.get_variable(config["hiflying_light_id"])
-    cg.add(var.set_parent(parent))
+    if CONF_HUB_ID in config:
+        hub = await cg.get_variable(config[CONF_HUB_ID])
+        lamp = hub.add_lamp(config[CONF_INSTANCE_ID], config.get(CONF_PROTOCOL, HUB_PROTOCOLS["both"]))
+        cg.add(var.set_hub(hub, lamp))
+    else:
+        parent = await cg.get_variable(config[CONF_HIFLYING_LIGHT_ID])
+        cg.add(var.set_parent(parent))
     
     if config["color_temperature"]:
-        cg.add(var.set_color_temperature_support(True)) 
\ No newline at end of file
+        cg.add(var.set_color_temperature_support(True))
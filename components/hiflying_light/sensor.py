@@ -0,0 +1,91 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_MILLISECOND,
+)
+
+from . import HiFlyingLightComponent, hiflying_light_ns
+
+CONF_ENCODE_TIME = "encode_time"
+CONF_BLOCKED_TIME = "blocked_time"
+CONF_COMMANDS_PER_MINUTE = "commands_per_minute"
+CONF_QUEUE_DEPTH = "queue_depth"
+CONF_DROPPED = "dropped"
+CONF_COALESCED = "coalesced"
+CONF_SUPPRESSED = "suppressed"
+CONF_FLASH_SAVES = "flash_saves"
+
+UNIT_MICROSECOND = "µs"
+
+HiFlyingLightMetrics = hiflying_light_ns.class_(
+    "HiFlyingLightMetrics", cg.PollingComponent
+)
+
+# 區間統計 (平均編碼時間、最長阻塞時間、每分鐘命令數、目前佇列深度)
+MEASUREMENTS = {
+    CONF_ENCODE_TIME: sensor.sensor_schema(
+        unit_of_measurement=UNIT_MICROSECOND,
+        accuracy_decimals=1,
+        state_class=STATE_CLASS_MEASUREMENT,
+        icon="mdi:timer-outline",
+    ),
+    CONF_BLOCKED_TIME: sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLISECOND,
+        accuracy_decimals=2,
+        state_class=STATE_CLASS_MEASUREMENT,
+        icon="mdi:timer-sand",
+    ),
+    CONF_COMMANDS_PER_MINUTE: sensor.sensor_schema(
+        unit_of_measurement="commands/min",
+        accuracy_decimals=1,
+        state_class=STATE_CLASS_MEASUREMENT,
+        icon="mdi:speedometer",
+    ),
+    CONF_QUEUE_DEPTH: sensor.sensor_schema(
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_MEASUREMENT,
+        icon="mdi:tray-full",
+    ),
+}
+
+# 累計計數
+TOTALS = {
+    key: sensor.sensor_schema(
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        icon="mdi:counter",
+    )
+    for key in (CONF_DROPPED, CONF_COALESCED, CONF_SUPPRESSED, CONF_FLASH_SAVES)
+}
+
+CONFIG_SCHEMA = (
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(HiFlyingLightMetrics),
+            cv.Required("hiflying_light_id"): cv.use_id(HiFlyingLightComponent),
+            **{cv.Optional(key): schema for key, schema in MEASUREMENTS.items()},
+            **{cv.Optional(key): schema for key, schema in TOTALS.items()},
+        }
+    )
+    .extend(cv.polling_component_schema("60s"))
+)
+
+
+async def to_code(config):
+    # 只有設定感測器時才編譯計時統計
+    cg.add_define("USE_HIFLYING_LIGHT_METRICS")
+
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    parent = await cg.get_variable(config["hiflying_light_id"])
+    cg.add(var.set_parent(parent))
+
+    for key in (*MEASUREMENTS, *TOTALS):
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, f"set_{key}_sensor")(sens))
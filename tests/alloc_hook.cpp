@@ -0,0 +1,26 @@
+#include "alloc_hook.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace hiflying_test {
+
+static std::atomic<size_t> allocations{0};
+
+size_t allocation_count() { return allocations.load(); }
+
+}  // namespace hiflying_test
+
+void *operator new(std::size_t size) {
+  hiflying_test::allocations++;
+  if (void *ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
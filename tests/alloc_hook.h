@@ -0,0 +1,12 @@
+#pragma once
+
+// 取代全域 operator new 以計算配置次數 (連結 alloc_hook.cpp 的測試才可使用)
+
+#include <cstddef>
+
+namespace hiflying_test {
+
+// 程式啟動以來 operator new 被呼叫的次數
+size_t allocation_count();
+
+}  // namespace hiflying_test
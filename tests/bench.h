@@ -0,0 +1,32 @@
+#pragma once
+
+// 主機微基準測試的共用計時工具: 重複執行直到累計時間足夠，輸出每次操作的奈秒數
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace hiflying_test {
+
+// 防止編譯器消除被測程式碼
+template<typename T> inline void do_not_optimize(const T &value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+// 第一個命令列參數為最少迭代次數 (ctest 以小值執行，只確認可以運作)
+inline long bench_iterations(int argc, char **argv, long fallback) {
+  return argc > 1 ? std::atol(argv[1]) : fallback;
+}
+
+template<typename F> inline double bench_ns(const char *name, long iterations, F &&body) {
+  using clock = std::chrono::steady_clock;
+  for (long i = 0; i < iterations / 10 + 1; i++)
+    body(uint32_t(i));
+  auto start = clock::now();
+  for (long i = 0; i < iterations; i++)
+    body(uint32_t(i));
+  double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / double(iterations);
+  std::printf("%-40s %10.1f ns/op\n", name, ns);
+  return ns;
+}
+
+}  // namespace hiflying_test
@@ -0,0 +1,74 @@
+// 批次編碼器與逐一編碼的吞吐量 (每秒生成的封包數，HF 與 Deli16 各一個)
+// 以三種編譯選項各建置一次 (見 CMakeLists.txt): 預設 Release (-O3)、-O2，以及模擬 ESP32 的 -Os 無 SIMD
+// 用法: bench_batch [重複次數]
+
+#include "bench.h"
+
+#include "../components/hiflying_light/hiflying_batch.h"
+
+#include <chrono>
+#include <vector>
+
+using namespace esphome::hiflying_light;
+using hiflying_test::do_not_optimize;
+
+int main(int argc, char **argv) {
+  const long rounds = hiflying_test::bench_iterations(argc, argv, 200);
+  const size_t count = 4096;
+  std::vector<uint8_t> address0(count), address1(count), param0(count), param1(count), param2(count), random(count);
+  std::vector<uint16_t> counter(count);
+  std::vector<int8_t> ctrl_code(count);
+  uint32_t state = 20261017;
+  auto next = [&state]() {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  };
+  for (size_t i = 0; i < count; i++) {
+    address0[i] = next();
+    address1[i] = next();
+    param0[i] = next();
+    param1[i] = next();
+    param2[i] = next();
+    random[i] = next();
+    counter[i] = next();
+    ctrl_code[i] = i % 16 == 0 ? BATCH_PAIR_CTRL_CODE : int8_t(next());
+  }
+  BatchInput in{count,         address0.data(), address1.data(), counter.data(), ctrl_code.data(),
+                param0.data(), param1.data(),   param2.data(),   random.data(),  3};
+  std::vector<Packet> single(2 * count), batch(2 * count);
+
+  using clock = std::chrono::steady_clock;
+  auto start = clock::now();
+  for (long r = 0; r < rounds; r++) {
+    for (size_t i = 0; i < count; i++) {
+      std::array<uint8_t, 5> mac = {address0[i], address1[i], 0, 0, 0};
+      std::array<uint8_t, 3> params = {param0[i], param1[i], param2[i]};
+      single[i] = generate_hf_packet(mac, 3, uint16_t(counter[i] + r), ctrl_code[i], params, random[i]);
+      single[count + i] = generate_deli16_packet(mac, 3, uint16_t(counter[i] + r), ctrl_code[i], params);
+    }
+    do_not_optimize(single.data());
+  }
+  auto mid = clock::now();
+  for (long r = 0; r < rounds; r++) {
+    // 與逐一編碼相同的計數器
+    for (size_t i = 0; i < count; i++)
+      counter[i] = uint16_t(counter[i] + (r == 0 ? 0 : 1));
+    encode_batch(in, batch.data());
+    do_not_optimize(batch.data());
+  }
+  auto end = clock::now();
+
+  if (single != batch) {
+    std::printf("encode_batch output differs from the single-packet encoders\n");
+    return 1;
+  }
+  double single_s = std::chrono::duration<double>(mid - start).count();
+  double batch_s = std::chrono::duration<double>(end - mid).count();
+  double packets = 2.0 * count * rounds;
+  std::printf("bitwise CRC: %s\n", BATCH_BITWISE_CRC ? "yes (SIMD)" : "no (tables)");
+  std::printf("single %.1f M packets/s, batch %.1f M packets/s, %.2fx\n", packets / single_s / 1e6,
+              packets / batch_s / 1e6, single_s / batch_s);
+  return 0;
+}
@@ -0,0 +1,108 @@
+// 元件層級的主機微基準測試 (實際時鐘): 命令從呼叫到入隊所佔用 ESPHome loop 的時間，
+// 以及 32 個燈具用獨立元件與集線器的比較 (RAM、閒置 loop()、同時漸變時丟棄的命令)
+// 用法: bench_light [迭代次數]
+
+#include "bench.h"
+#include "simulator.h"
+
+#include "esphome/core/log.h"
+#include "hiflying_hub.h"
+
+#include <chrono>
+#include <memory>
+
+using namespace esphome::hiflying_light;
+
+// 只計時 body，每次之後執行 settle (不計時)，輸出每次操作的微秒數
+template<typename F, typename G> static double time_us(const char *name, long iterations, F &&body, G &&settle) {
+  using clock = std::chrono::steady_clock;
+  clock::duration total{};
+  for (long i = 0; i < iterations; i++) {
+    auto start = clock::now();
+    body(uint32_t(i));
+    total += clock::now() - start;
+    settle();
+  }
+  double us = std::chrono::duration<double, std::micro>(total).count() / double(iterations);
+  std::printf("%-40s %10.2f us/op\n", name, us);
+  return us;
+}
+
+// 開/關命令: 預編碼時直接複製閒置時準備好的幀，不需要編碼與查詢 MAC
+static void bench_pre_encode(long iterations) {
+  const PreEncodeMode modes[] = {PRE_ENCODE_NONE, PRE_ENCODE_ON_OFF};
+  const char *const names[] = {"send_command ON/OFF (pre_encode none)", "send_command ON/OFF (pre_encode on_off)"};
+  for (int m = 0; m < 2; m++) {
+    HiFlyingLightComponent component;
+    component.set_instance_id(uint8_t(m + 1));
+    component.set_pre_encode(modes[m]);
+    component.setup();
+    auto *radio = HiFlyingRadio::get();
+    time_us(
+        names[m], iterations, [&](uint32_t i) { component.send_command(i % 2 ? COMMAND_OFF : COMMAND_ON); },
+        [&]() {
+          radio->flush();
+          // 閒置的 loop() 每次重新編碼一個過期的槽位
+          component.loop();
+          component.loop();
+        });
+  }
+}
+
+// 32 個燈具: 每個燈具一個元件，或一個集線器
+static void bench_hub(long iterations) {
+  const int lamps = 32;
+  std::printf("%d lamps: components %zu B, hub %zu B\n", lamps, lamps * sizeof(HiFlyingLightComponent),
+              sizeof(HiFlyingLightHub) + lamps * sizeof(HubLamp));
+
+  std::vector<std::unique_ptr<HiFlyingLightComponent>> components;
+  std::vector<HiFlyingLightComponent *> component_ptrs;
+  for (int i = 0; i < lamps; i++) {
+    components.emplace_back(new HiFlyingLightComponent());
+    components.back()->set_instance_id(uint8_t(i + 1));
+    components.back()->setup();
+    component_ptrs.push_back(components.back().get());
+  }
+  HiFlyingLightHub hub;
+  for (int i = 0; i < lamps; i++)
+    hub.add_lamp(uint8_t(i + 1), PROTOCOL_BOTH);
+  hub.setup();
+  std::vector<HiFlyingLightHub *> hubs = {&hub};
+
+  auto idle_components = [&](uint32_t) {
+    for (auto *component : component_ptrs)
+      component->loop();
+  };
+  time_us("idle loop() x32 components", iterations, idle_components, []() {});
+  time_us("idle loop() hub", iterations, [&](uint32_t) { hub.loop(); }, []() {});
+
+  // 所有燈具同時漸變 2 秒 (每 ms 一個新亮度)，佇列已滿時的警告不輸出
+  auto *radio = HiFlyingRadio::get();
+  int log_level = esphome::host_log_level;
+  esphome::host_log_level = esphome::HOST_LOG_ERROR;
+  uint32_t dropped = radio->get_dropped();
+  for (int t = 0; t < 2000; t++) {
+    for (int i = 0; i < lamps; i++)
+      components[i]->set_brightness(uint16_t(1 + (t * 7 + i) % 1000));
+    hiflying_test::tick(component_ptrs);
+  }
+  hiflying_test::run_until_idle(component_ptrs);
+  uint32_t components_dropped = radio->get_dropped() - dropped;
+  dropped = radio->get_dropped();
+  for (int t = 0; t < 2000; t++) {
+    for (int i = 0; i < lamps; i++)
+      hub.set_brightness(uint8_t(i), uint16_t(1 + (t * 7 + i) % 1000));
+    hiflying_test::tick(hubs);
+  }
+  hiflying_test::run_until_idle(hubs);
+  esphome::host_log_level = log_level;
+  std::printf("2 s transition on all lamps: components dropped %u, hub dropped %u\n", components_dropped,
+              radio->get_dropped() - dropped);
+}
+
+int main(int argc, char **argv) {
+  const long iterations = hiflying_test::bench_iterations(argc, argv, 20000);
+  bench_pre_encode(iterations);
+  bench_hub(iterations);
+  return 0;
+}
@@ -0,0 +1,81 @@
+// 編碼器微基準測試: 每個 HF/Deli16 封包的編碼時間 (ns/packet)，並與凍結的參考實現比較
+// 用法: bench_protocol [迭代次數]
+
+#include "bench.h"
+
+#include "../components/hiflying_light/hiflying_protocol.h"
+#include "../components/hiflying_light/hiflying_reference.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace esphome::hiflying_light;
+using hiflying_test::bench_ns;
+using hiflying_test::do_not_optimize;
+
+int main(int argc, char **argv) {
+  const long iterations = hiflying_test::bench_iterations(argc, argv, 2000000);
+  const std::array<uint8_t, 5> mac = {0x24, 0x6f, 0x28, 0x1a, 0x3c};
+  std::printf("CRC16 table: %zu entries\n", CRC16_TABLE_SIZE);
+
+  bench_ns("generate_hf_packet", iterations, [&](uint32_t i) {
+    std::array<uint8_t, 3> params = {0, uint8_t(i >> 8), uint8_t(i)};
+    do_not_optimize(generate_hf_packet(mac, 3, uint16_t(i), -75, params, uint8_t(i * 31)));
+  });
+  bench_ns("generate_deli16_packet", iterations, [&](uint32_t i) {
+    std::array<uint8_t, 3> params = {0, uint8_t(i >> 8), uint8_t(i)};
+    do_not_optimize(generate_deli16_packet(mac, 3, uint16_t(i), -75, params));
+  });
+  bench_ns("build_adv_frame", iterations, [&](uint32_t i) {
+    Packet packet{};
+    packet[0] = uint8_t(i);
+    do_not_optimize(build_adv_frame(packet));
+  });
+  bench_ns("reference::generate_hf_packet", iterations / 4 + 1, [&](uint32_t i) {
+    std::array<uint8_t, 3> params = {0, uint8_t(i >> 8), uint8_t(i)};
+    do_not_optimize(reference::generate_hf_packet(mac, 3, uint16_t(i), -75, params, uint8_t(i * 31)).data());
+  });
+  bench_ns("reference::generate_deli16_packet", iterations / 4 + 1, [&](uint32_t i) {
+    std::array<uint8_t, 3> params = {0, uint8_t(i >> 8), uint8_t(i)};
+    do_not_optimize(reference::generate_deli16_packet(mac, 3, uint16_t(i), -75, params).data());
+  });
+
+  // CRC16: 查表 (256 或 16 項，依 USE_HIFLYING_LIGHT_CRC_NIBBLE_TABLE) 與逐位元的參考實現，HF 封包的 13 字節
+  uint8_t crc_data[13];
+  std::vector<uint8_t> crc_vector(13);
+  for (int i = 0; i < 13; i++)
+    crc_data[i] = crc_vector[i] = uint8_t(i * 29 + 7);
+  bench_ns("calculate_crc16 (13 bytes)", iterations, [&](uint32_t i) {
+    crc_data[0] = uint8_t(i);
+    do_not_optimize(calculate_crc16(crc_data, sizeof(crc_data), 0));
+  });
+  bench_ns("reference::calculate_crc16 (13 bytes)", iterations / 4 + 1, [&](uint32_t i) {
+    crc_vector[0] = uint8_t(i);
+    do_not_optimize(reference::calculate_crc16(crc_vector, 0, crc_vector.size(), 0));
+  });
+
+  // Deli16 白化: 優化前以 LFSR 逐位元處理兩次 (13 + 29 字節)，現在與編譯期遮罩 XOR 16 字節
+  std::vector<uint8_t> whitening(29), whitening_inner(13);
+  bench_ns("reference::apply_bit_operation x2", iterations / 4 + 1, [&](uint32_t i) {
+    whitening[16] = uint8_t(i);
+    std::copy(whitening.begin() + 16, whitening.end(), whitening_inner.begin());
+    reference::apply_bit_operation(whitening_inner, 13, 63);
+    std::copy(whitening_inner.begin(), whitening_inner.end(), whitening.begin() + 16);
+    reference::apply_bit_operation(whitening, 29, 37);
+    do_not_optimize(whitening.data());
+  });
+  uint8_t whitened[29] = {};
+  bench_ns("DELI16_WHITENING_MASK", iterations, [&](uint32_t i) {
+    whitened[16] = uint8_t(i);
+    for (int j = 13; j < 29; j++)
+      whitened[j] ^= DELI16_WHITENING_MASK[j];
+    do_not_optimize(whitened);
+  });
+
+  // 加密表: 優化前每個封包都以 TEA 重新計算，現在是編譯期常數
+  bench_ns("reference::get_encryption_table", iterations / 4 + 1, [&](uint32_t i) {
+    do_not_optimize(reference::get_encryption_table()[i & 0x0f]);
+  });
+  bench_ns("ENCRYPTION_TABLE", iterations, [&](uint32_t i) { do_not_optimize(ENCRYPTION_TABLE[i & 0x0f]); });
+  return 0;
+}
@@ -0,0 +1,264 @@
+// 端到端模擬基準測試: 透過 HiFlyingLightOutput::write_state 驅動元件，以模擬廣播器量測
+// 每個命令的延遲、總空中時間與每秒幀數 (虛擬時鐘，結果與主機速度無關且可以重現)。
+// 各選項的場景都以關閉與開啟各執行一次: adaptive_repeats、compound_commands、framing、優先級與搶佔
+// 用法: bench_simulator [重複次數]
+
+#include "bench.h"
+#include "simulator.h"
+
+#include "esphome/components/light/light_state.h"
+
+#include <memory>
+
+using namespace esphome::hiflying_light;
+using esphome::light::ColorMode;
+using esphome::light::LightState;
+using hiflying_test::LatencyStats;
+using hiflying_test::simulator;
+using hiflying_test::tick;
+
+static void set_state(LightState &state, float brightness, float mireds, bool final) {
+  state.current_values.color_mode = ColorMode::COLOR_TEMPERATURE;
+  state.current_values.brightness = brightness;
+  state.current_values.color_temperature = mireds;
+  if (final)
+    state.remote_values = state.current_values;
+}
+
+// 每個 write_state 都是最終值 (沒有漸變): 開燈、調整亮度或色溫、關燈
+static void scenario_commands(long rounds) {
+  HiFlyingLightComponent component;
+  component.set_instance_id(1);
+  component.setup();
+  HiFlyingLightOutput output;
+  output.set_parent(&component);
+  output.set_color_temperature_support(true);
+  LightState state;
+  output.setup_state(&state);
+  std::vector<HiFlyingLightComponent *> components = {&component};
+  auto *radio = HiFlyingRadio::get();
+  auto *sim = simulator();
+  hiflying_test::run_until_idle(components);
+  sim->reset();
+
+  LatencyStats first_frame, complete;
+  uint32_t start = sim->now();
+  for (long round = 0; round < rounds; round++) {
+    const float steps[][2] = {{0.5f, 250.0f}, {0.8f, 250.0f}, {0.8f, 400.0f}, {0.2f, 300.0f}, {0.0f, 300.0f}};
+    for (const auto &step : steps) {
+      uint32_t frames = sim->get_frames();
+      uint32_t issued = sim->now();
+      set_state(state, step[0], step[1] + float(round % 7), true);
+      output.write_state(&state);
+      while (sim->get_frames() == frames && sim->now() - issued < 1000)
+        tick(components);
+      first_frame.add(sim->now() - issued);
+      hiflying_test::run_until_idle(components);
+      complete.add(radio->get_last_latency());
+    }
+  }
+  uint32_t elapsed = sim->now() - start;
+  std::printf("write_state commands (%ld rounds, 5 commands each):\n", rounds);
+  first_frame.print("command -> first frame");
+  complete.print("command -> last repetition");
+  std::printf("  airtime %.1f ms, frames %u, %.1f frames/s over %u ms\n", sim->get_airtime_us() / 1000.0,
+              sim->get_frames(), sim->get_frames() * 1000.0 / elapsed, elapsed);
+}
+
+// 1 s 亮度漸變: 每 16 ms 一次 write_state (中間值)，之後保持 500 ms
+// adaptive_repeats 時中間值只發送一次，最終值多發送一次
+static void scenario_transition(long rounds, bool adaptive) {
+  HiFlyingLightComponent component;
+  component.set_instance_id(adaptive ? 3 : 2);
+  component.set_adaptive_repeats(adaptive);
+  component.setup();
+  HiFlyingLightOutput output;
+  output.set_parent(&component);
+  LightState state;
+  output.setup_state(&state);
+  std::vector<HiFlyingLightComponent *> components = {&component};
+  auto *radio = HiFlyingRadio::get();
+  auto *sim = simulator();
+  set_state(state, 0.1f, 300.0f, true);
+  output.write_state(&state);
+  hiflying_test::run_until_idle(components);
+  sim->reset();
+  uint32_t dropped = radio->get_dropped();
+
+  uint32_t start = sim->now();
+  for (long round = 0; round < rounds; round++) {
+    for (int t = 0; t <= 1000; t += 16) {
+      bool final = t + 16 > 1000;
+      float from = round % 2 ? 1.0f : 0.1f, to = round % 2 ? 0.1f : 1.0f;
+      set_state(state, from + (to - from) * (final ? 1.0f : t / 1000.0f), 300.0f, final);
+      output.write_state(&state);
+      tick(components, 16);
+    }
+    tick(components, 500);
+  }
+  uint32_t elapsed = sim->now() - start;
+  std::printf("1 s brightness transition, adaptive_repeats %s (%ld rounds, write_state every 16 ms):\n",
+              adaptive ? "true" : "false", rounds);
+  std::printf("  per round: airtime %.1f ms, frames %.1f\n", sim->get_airtime_us() / 1000.0 / rounds,
+              double(sim->get_frames()) / rounds);
+  std::printf("  airtime %.1f ms, frames %u, %.1f frames/s, max latency %u ms, dropped %u\n",
+              sim->get_airtime_us() / 1000.0, sim->get_frames(), sim->get_frames() * 1000.0 / elapsed,
+              radio->get_max_latency(), radio->get_dropped() - dropped);
+}
+
+// 從關燈狀態以亮度與色溫開燈 (開燈、亮度、色溫三個命令)，量測每個不同 AD 幀第一次廣播的時間
+// compound_commands 時三個命令在同一個突發中交錯，否則依序發送
+static void scenario_compound(long rounds, bool compound) {
+  HiFlyingLightComponent component;
+  component.set_instance_id(compound ? 5 : 4);
+  component.set_compound_commands(compound);
+  component.setup();
+  HiFlyingLightOutput output;
+  output.set_parent(&component);
+  output.set_color_temperature_support(true);
+  LightState state;
+  output.setup_state(&state);
+  std::vector<HiFlyingLightComponent *> components = {&component};
+  auto *sim = simulator();
+
+  LatencyStats last_first_frame;
+  uint32_t airtime_us = 0;
+  for (long round = 0; round < rounds; round++) {
+    set_state(state, 0.0f, 300.0f, true);
+    output.write_state(&state);
+    hiflying_test::run_until_idle(components);
+
+    uint32_t airtime = sim->get_airtime_us();
+    uint32_t issued = sim->now();
+    set_state(state, 0.3f + 0.1f * float(round % 5), 250.0f + float(round % 7) * 10, true);
+    output.write_state(&state);
+    // 依序發送時亮度與色溫經由串流在前一個命令完成後才入隊，固定觀察 1 s
+    std::vector<AdvFrame> seen;
+    uint32_t last = 0;
+    for (int t = 0; t < 1000; t++) {
+      tick(components);
+      for (size_t i = 0; i < sim->event_count(); i++) {
+        const SimEvent &event = sim->event(i);
+        if (event.type != SIM_PAYLOAD || event.time < issued || std::count(seen.begin(), seen.end(), event.data))
+          continue;
+        seen.push_back(event.data);
+        last = event.time - issued;
+      }
+    }
+    last_first_frame.add(last);
+    airtime_us += sim->get_airtime_us() - airtime;
+  }
+  std::printf("turn on with brightness and colour temperature, compound_commands %s (%ld rounds):\n",
+              compound ? "true" : "false", rounds);
+  last_first_frame.print("command -> last first frame");
+  std::printf("  airtime per turn-on %.1f ms\n", airtime_us / 1000.0 / rounds);
+}
+
+// 每種封裝策略發送 100 個開/關命令，比較總空中時間
+static void scenario_framing() {
+  const AdvFraming framings[] = {FRAMING_UUID_LIST, FRAMING_RAW, FRAMING_MANUFACTURER};
+  auto *radio = HiFlyingRadio::get();
+  auto *sim = simulator();
+  std::printf("100 ON/OFF commands per framing:\n");
+  uint32_t base = 0;
+  for (AdvFraming framing : framings) {
+    HiFlyingLightComponent component;
+    component.set_instance_id(uint8_t(6 + framing));
+    component.set_framing(framing);
+    component.setup();
+    radio->flush();
+    sim->reset();
+    for (int i = 0; i < 100; i++) {
+      component.send_command(i % 2 ? COMMAND_OFF : COMMAND_ON);
+      radio->flush();
+    }
+    uint32_t airtime = sim->get_airtime_us();
+    if (base == 0)
+      base = airtime;
+    uint8_t length = adv_frame_length(framing);
+    std::printf("  %-12s AD %2u bytes, PDU %3u us, airtime %6.1f ms (%5.1f%%)\n", framing_to_string(framing), length,
+                adv_pdu_airtime_us(length), airtime / 1000.0, 100.0 * airtime / base);
+  }
+}
+
+// 4 個燈具持續漸變 (每 16 ms 一個中間值)，每秒對其中一個燈具關燈、500 ms 後再開燈，
+// 量測關燈命令到第一份與最後一份 HF 封包的時間。priority 為 false 時關燈與串流同樣是優先級 0 且不搶佔
+// (只有通道輪詢)
+static void scenario_preemption(long rounds, bool priority) {
+  const int lamps = 4;
+  std::vector<std::unique_ptr<HiFlyingLightComponent>> owned;
+  std::vector<HiFlyingLightComponent *> components;
+  for (int i = 0; i < lamps; i++) {
+    owned.emplace_back(new HiFlyingLightComponent());
+    auto *component = owned.back().get();
+    component->set_instance_id(uint8_t(10 + i + (priority ? lamps : 0)));
+    component->set_preemption(priority);
+    if (!priority) {
+      component->set_repeat_policy(COMMAND_ON, 0, 0, 0);
+      component->set_repeat_policy(COMMAND_OFF, 0, 0, 0);
+    }
+    component->setup();
+    components.push_back(component);
+  }
+  auto *sim = simulator();
+  CommandInfo off_info;
+  HiFlyingLightComponent::get_command_info(COMMAND_OFF, off_info);
+  for (auto *component : components)
+    component->turn_on();
+  hiflying_test::run_until_idle(components);
+
+  LatencyStats first_frame, last_frame;
+  uint32_t off_at = 0, copies = 0;
+  int off_lamp = -1;
+  for (uint32_t t = 0; t < uint32_t(rounds) * 1000; t++) {
+    for (int i = 0; i < lamps; i++) {
+      if (i != off_lamp && (t + i * 4) % 16 == 0)
+        components[i]->set_brightness(uint16_t(100 + (t / 16 * 37 + i * 101) % 900), false);
+    }
+    if (t % 1000 == 7) {
+      off_lamp = (t / 1000) % lamps;
+      off_at = sim->now();
+      copies = 0;
+      components[off_lamp]->turn_off();
+    }
+    if (off_lamp >= 0 && t % 1000 == 507) {
+      components[off_lamp]->turn_on();
+      off_lamp = -1;
+    }
+    tick(components);
+    // 這一毫秒開始的廣播中解碼 HF 關燈封包
+    for (size_t i = 0; i < sim->event_count(); i++) {
+      const SimEvent &event = sim->event(i);
+      if (event.type != SIM_PAYLOAD || event.time + 1 != sim->now() || off_at == 0)
+        continue;
+      Packet packet;
+      std::copy(event.data.begin() + 5, event.data.begin() + 31, packet.begin());
+      DecodedCommand cmd;
+      if (!decode_hf_packet(packet, cmd) || cmd.ctrl_code != off_info.ctrl_code)
+        continue;
+      if (copies == 0)
+        first_frame.add(event.time - off_at);
+      if (++copies == 3)
+        last_frame.add(event.time - off_at);
+    }
+  }
+  hiflying_test::run_until_idle(components);
+  std::printf("OFF while %d lamps stream transitions, %s (%ld OFF commands):\n", lamps,
+              priority ? "priority + preemption" : "round-robin only", rounds);
+  first_frame.print("OFF -> first HF frame");
+  last_frame.print("OFF -> last HF frame");
+}
+
+int main(int argc, char **argv) {
+  const long rounds = hiflying_test::bench_iterations(argc, argv, 20);
+  std::printf("advertiser: %s\n", HiFlyingRadio::get()->get_advertiser()->get_name());
+  scenario_commands(rounds);
+  scenario_transition(rounds, false);
+  scenario_transition(rounds, true);
+  scenario_compound(rounds, false);
+  scenario_compound(rounds, true);
+  scenario_framing();
+  scenario_preemption(rounds, false);
+  scenario_preemption(rounds, true);
+  return 0;
+}
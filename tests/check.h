@@ -0,0 +1,55 @@
+#pragma once
+
+// 主機測試使用的最小斷言巨集: 失敗時輸出位置並累計，main() 以 check_result() 作為結束碼
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace hiflying_test {
+
+inline int &failures() {
+  static int count = 0;
+  return count;
+}
+
+inline int check_result(const char *name) {
+  if (failures() == 0) {
+    std::printf("%s: OK\n", name);
+    return 0;
+  }
+  std::printf("%s: %d check(s) failed\n", name, failures());
+  return 1;
+}
+
+// 將 26 字節封包轉成十六進位字串後與基準比對
+template<typename T> inline bool equals_hex(const T &bytes, const char *hex) {
+  char buffer[2 * 64 + 1];
+  size_t length = 0;
+  for (auto b : bytes) {
+    std::snprintf(buffer + length, sizeof(buffer) - length, "%02x", unsigned(b));
+    length += 2;
+  }
+  return std::strcmp(buffer, hex) == 0;
+}
+
+}  // namespace hiflying_test
+
+#define CHECK(expr) \
+  do { \
+    if (!(expr)) { \
+      std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+      hiflying_test::failures()++; \
+    } \
+  } while (0)
+
+#define CHECK_EQ(a, b) \
+  do { \
+    auto check_a_ = (a); \
+    auto check_b_ = (b); \
+    if (!(check_a_ == check_b_)) { \
+      std::printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, #a, #b, \
+                  (long long) check_a_, (long long) check_b_); \
+      hiflying_test::failures()++; \
+    } \
+  } while (0)
@@ -0,0 +1,157 @@
+// 差分模糊測試: 優化後的編碼器 (hiflying_protocol.h、hiflying_batch.h) 與凍結的逐位元參考實現
+// (hiflying_reference.h) 對任意輸入必須產生逐字節相同的封包
+// Clang 以 -fsanitize=fuzzer 建置 (libFuzzer)，其他編譯器以內建的驅動程式執行固定種子的隨機輸入，
+// 或重播命令列給出的檔案: fuzz_protocol [迭代次數 | 檔案...]
+
+#include "../components/hiflying_light/hiflying_batch.h"
+#include "../components/hiflying_light/hiflying_protocol.h"
+#include "../components/hiflying_light/hiflying_reference.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace esphome::hiflying_light;
+
+// 每個命令佔用 13 字節: MAC (5)、page、計數器 (2)、ctrl_code、參數 (3)、HF 隨機字節
+static const size_t RECORD_SIZE = 13;
+
+struct FuzzCommand {
+  std::array<uint8_t, 5> mac;
+  uint8_t page;
+  uint16_t counter;
+  int8_t ctrl_code;
+  std::array<uint8_t, 3> params;
+  uint8_t random;
+};
+
+static FuzzCommand parse(const uint8_t *data) {
+  FuzzCommand cmd;
+  std::copy(data, data + 5, cmd.mac.begin());
+  cmd.page = data[5];
+  cmd.counter = uint16_t(data[6] | data[7] << 8);
+  cmd.ctrl_code = int8_t(data[8]);
+  std::copy(data + 9, data + 12, cmd.params.begin());
+  cmd.random = data[12];
+  return cmd;
+}
+
+static void check(bool same, const char *what, const FuzzCommand &cmd) {
+  if (same)
+    return;
+  std::fprintf(stderr, "%s differs: mac %02x%02x%02x%02x%02x page %u counter 0x%04x ctrl %d params %02x%02x%02x "
+               "random 0x%02x\n", what, cmd.mac[0], cmd.mac[1], cmd.mac[2], cmd.mac[3], cmd.mac[4], cmd.page,
+               cmd.counter, cmd.ctrl_code, cmd.params[0], cmd.params[1], cmd.params[2], cmd.random);
+  std::abort();
+}
+
+static bool same_packet(const Packet &packet, const std::vector<uint8_t> &expected) {
+  return expected.size() == packet.size() && std::equal(packet.begin(), packet.end(), expected.begin());
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  size_t count = size / RECORD_SIZE;
+  if (count == 0)
+    return 0;
+
+  std::vector<FuzzCommand> commands;
+  std::vector<std::vector<uint8_t>> hf, deli16;
+  for (size_t i = 0; i < count; i++) {
+    FuzzCommand cmd = parse(data + i * RECORD_SIZE);
+    auto expected_hf = reference::generate_hf_packet(cmd.mac, cmd.page, cmd.counter, cmd.ctrl_code, cmd.params,
+                                                     cmd.random);
+    auto expected_deli16 = reference::generate_deli16_packet(cmd.mac, cmd.page, cmd.counter, cmd.ctrl_code,
+                                                             cmd.params);
+    check(same_packet(generate_hf_packet(cmd.mac, cmd.page, cmd.counter, cmd.ctrl_code, cmd.params, cmd.random),
+                      expected_hf),
+          "generate_hf_packet", cmd);
+    check(same_packet(generate_deli16_packet(cmd.mac, cmd.page, cmd.counter, cmd.ctrl_code, cmd.params),
+                      expected_deli16),
+          "generate_deli16_packet", cmd);
+
+    // CRC16 的查表與逐位元實現 (長度 0-13)
+    std::vector<uint8_t> bytes(data + i * RECORD_SIZE, data + (i + 1) * RECORD_SIZE);
+    size_t length = cmd.random % (RECORD_SIZE + 1);
+    check(calculate_crc16(bytes.data(), length, cmd.counter) ==
+              reference::calculate_crc16(bytes, 0, length, cmd.counter),
+          "calculate_crc16", cmd);
+
+    commands.push_back(cmd);
+    hf.push_back(expected_hf);
+    deli16.push_back(expected_deli16);
+  }
+
+  // 批次編碼: 所有命令共用第一個命令的 page
+  const uint8_t page = commands[0].page;
+  std::vector<uint8_t> address0, address1, param0, param1, param2, random;
+  std::vector<uint16_t> counter;
+  std::vector<int8_t> ctrl_code;
+  for (const auto &cmd : commands) {
+    address0.push_back(cmd.mac[0]);
+    address1.push_back(cmd.mac[1]);
+    counter.push_back(cmd.counter);
+    ctrl_code.push_back(cmd.ctrl_code);
+    param0.push_back(cmd.params[0]);
+    param1.push_back(cmd.params[1]);
+    param2.push_back(cmd.params[2]);
+    random.push_back(cmd.random);
+  }
+  BatchInput in{count,         address0.data(), address1.data(), counter.data(), ctrl_code.data(),
+                param0.data(), param1.data(),   param2.data(),   random.data(),  page};
+  std::vector<Packet> out(2 * count);
+  encode_batch(in, out.data());
+  for (size_t i = 0; i < count; i++) {
+    const FuzzCommand &cmd = commands[i];
+    bool same_page = cmd.page == page;
+    check(same_packet(out[i], same_page ? hf[i]
+                                        : reference::generate_hf_packet(cmd.mac, page, cmd.counter, cmd.ctrl_code,
+                                                                        cmd.params, cmd.random)),
+          "encode_batch (HF)", cmd);
+    check(same_packet(out[count + i], same_page ? deli16[i]
+                                                : reference::generate_deli16_packet(cmd.mac, page, cmd.counter,
+                                                                                    cmd.ctrl_code, cmd.params)),
+          "encode_batch (Deli16)", cmd);
+  }
+  return 0;
+}
+
+#ifndef HIFLYING_LIBFUZZER
+// 沒有 libFuzzer 時的驅動程式: 數字參數為迭代次數 (預設 20000)，其他參數為要重播的輸入檔案
+int main(int argc, char **argv) {
+  if (argc > 1 && (argv[1][0] < '0' || argv[1][0] > '9')) {
+    for (int i = 1; i < argc; i++) {
+      FILE *file = std::fopen(argv[i], "rb");
+      if (file == nullptr) {
+        std::fprintf(stderr, "cannot open %s\n", argv[i]);
+        return 1;
+      }
+      std::vector<uint8_t> data;
+      int c;
+      while ((c = std::fgetc(file)) != EOF)
+        data.push_back(uint8_t(c));
+      std::fclose(file);
+      LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+    std::printf("fuzz_protocol: %d input(s) OK\n", argc - 1);
+    return 0;
+  }
+
+  const long iterations = argc > 1 ? std::atol(argv[1]) : 20000;
+  uint32_t state = 20261017;
+  std::vector<uint8_t> data;
+  for (long i = 0; i < iterations; i++) {
+    // 1-40 個命令，跨過 BATCH_CHUNK 的邊界
+    size_t count = 1 + i % 40;
+    data.resize(count * RECORD_SIZE);
+    for (auto &byte : data) {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      byte = uint8_t(state);
+    }
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+  }
+  std::printf("fuzz_protocol: %ld random inputs OK\n", iterations);
+  return 0;
+}
+#endif
@@ -0,0 +1,620 @@
+#pragma once
+
+// 基準輸出 (golden vectors)，由優化前的 HiFlyingLightComponent 編碼器 (commit 5f0a589) 產生，
+// 任何編碼器修改都必須逐字節重現這些輸出。
+// 依序為: 每個命令 × 計數器邊界 (含 0xff/0x100 與 0xffff 迴繞) × 亮度邊界 (1/500/1000)、
+// 任意 ctrl_code/page/參數邊界，以及固定種子 (20261017) 的隨機輸入。
+
+#include <array>
+#include <cstdint>
+
+namespace esphome {
+namespace hiflying_light {
+namespace golden {
+
+struct Vector {
+  std::array<uint8_t, 5> mac;
+  uint8_t page;
+  uint16_t counter;
+  int8_t ctrl_code;
+  std::array<uint8_t, 3> params;
+  uint8_t random;
+  const char *hf;      // 26 字節 HF 封包 (十六進位)
+  const char *deli16;  // 26 字節 Deli16 封包 (十六進位)
+};
+
+// 優化前以 TEA 於執行期計算的加密表
+inline constexpr std::array<uint8_t, 16> ENCRYPTION_TABLE = {0x1d, 0x04, 0x11, 0x20, 0x98, 0x75, 0x28, 0x46,
+                                                             0x0b, 0xaf, 0x43, 0xac, 0xd6, 0xbe, 0x89, 0x8e};
+
+// apply_bit_operation_() 作用於全零緩衝區的輸出 (即密鑰流)
+inline constexpr std::array<uint8_t, 13> WHITENING_63 = {0xc7, 0x8d, 0xd2, 0x57, 0xa1, 0x3d, 0xa7,
+                                                         0x66, 0xb0, 0x75, 0x31, 0x11, 0x48};
+inline constexpr std::array<uint8_t, 29> WHITENING_37 = {0x8d, 0xd2, 0x57, 0xa1, 0x3d, 0xa7, 0x66, 0xb0, 0x75, 0x31,
+                                                         0x11, 0x48, 0x96, 0x77, 0xf8, 0xe3, 0x46, 0xe9, 0xab, 0xd0,
+                                                         0x9e, 0x53, 0x33, 0xd8, 0xba, 0x98, 0x08, 0x24, 0xcb};
+
+// calculate_crc16_() 對 data[i] = i * 29 + 7 的前 n 字節
+inline constexpr uint8_t crc_input(int i) { return uint8_t(i * 29 + 7); }
+struct CrcVector {
+  int length;
+  uint16_t crc;
+};
+inline constexpr CrcVector CRC_VECTORS[] = {{0, 0x0000}, {1, 0x70e7}, {13, 0xcd0f}, {32, 0x096d}};
+
+inline constexpr Vector VECTORS[] = {
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x0000, -76, {0x00, 0x00, 0x00}, 0x0b,
+     "48464b4a7bedb7370f5882d638e1c90adb1969e2101112131415",
+     "f90849b2ce2ca33f6d940a65c939ac0110111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0001, -76, {0x00, 0x00, 0x00}, 0x30,
+     "48464b4a07562ccf63ccf652ac6d3e8e5795969a101112131415",
+     "f90849b2ce2c863e6c950b0bed38b0ec10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x007f, -76, {0x00, 0x00, 0x00}, 0x55,
+     "48464b4a0a8e6d9130c9f367a7707fbb8c68a66c101112131415",
+     "f90849b2ce2c074012eb758a1246667e10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x0080, -76, {0x00, 0x00, 0x00}, 0x7a,
+     "48464b4a690a4949216a94c846cf5b18e90b8ebf101112131415",
+     "f90849b2ce2c23bfed148ae5c9b92e6610111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x00ff, -76, {0x00, 0x00, 0x00}, 0x9f,
+     "48464b4afffde2d76bd4fe5ab465f4865f9d9dd8101112131415",
+     "f90849b2ce2c78c0926bf5f5edc6fed210111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x0100, -76, {0x00, 0x00, 0x00}, 0xc4,
+     "48464b4a1c1516a33eb7e17d918228a57e7e9c30101112131415",
+     "f90849b2ce2c783f6d940af51239416110111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x1234, -76, {0x00, 0x00, 0x00}, 0xe9,
+     "48464b4ae1f57d1169f21cb0ce478ff031338da4101112131415",
+     "f90849b2ce2c970b59a03e51c90d0dc110111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x7fff, -76, {0x00, 0x00, 0x00}, 0x0e,
+     "48464b4a9ecd8138cc355ffb1304932700fcb8d1101112131415",
+     "f90849b2ce2c78c0926bf5f5edc6fed210111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x8000, -76, {0x00, 0x00, 0x00}, 0x33,
+     "48464b4a0a74289130c9f367a7703abb8c68e000101112131415",
+     "f90849b2ce2c783f6d940af51239416110111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0xfffe, -76, {0x00, 0x00, 0x00}, 0x58,
+     "48464b4a692c4b49216a94c846cf5d18e90bf57e101112131415",
+     "f90849b2ce2c5dc1936af49bc9c7e23f10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0xffff, -76, {0x00, 0x00, 0x00}, 0x7d,
+     "48464b4ae484c7f286ef19b5c94ad9ed36365d8c101112131415",
+     "f90849b2ce2c78c0926bf5f5edc6fed210111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x0000, -78, {0x00, 0x00, 0x00}, 0xa2,
+     "48464b4a1cef16a33eb7e17791bcdffce1cd3ca9101112131415",
+     "f90849b2ce2c783f6d940cf51239db2a10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x0001, -78, {0x00, 0x00, 0x00}, 0xc7,
+     "48464b4a7bb1b8370f5882dc38203a7a7f41a41d101112131415",
+     "f90849b2ce2ca23e6c950d64c938dd0c10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x007f, -78, {0x00, 0x00, 0x00}, 0xec,
+     "48464b4a164379c054bde7619bb44ef4e9a541aa101112131415",
+     "f90849b2ce2cf84012eb7375ed46e6fe10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x0080, -78, {0x00, 0x00, 0x00}, 0x11,
+     "48464b4a0a52a89130c9f36da7b84700e5a9c079101112131415",
+     "f90849b2ce2cf8bfed148c7512b9594d10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x00ff, -78, {0x00, 0x00, 0x00}, 0x36,
+     "48464b4ab289950058214b85ffde188abff35163101112131415",
+     "f90849b2ce2c5cc0926bf39ac9c6933210111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0100, -78, {0x00, 0x00, 0x00}, 0x5b,
+     "48464b4a9e189438cc355ff9133a5d7e634f1f6e101112131415",
+     "f90849b2ce2c873f6d940c0aed39c1e110111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x1234, -78, {0x00, 0x00, 0x00}, 0x80,
+     "48464b4a1cd14aa33eb7e1779185321b20e418e8101112131415",
+     "f90849b2ce2c4c0b59a038c1120d7aea10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x7fff, -78, {0x00, 0x00, 0x00}, 0xa5,
+     "48464b4a99717c59313a64fa16391d816648c402101112131415",
+     "f90849b2ce2c5cc0926bf39ac9c6933210111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x8000, -78, {0x00, 0x00, 0x00}, 0xca,
+     "48464b4aff2833d76bd4fe58b49bfedf04ae3a3b101112131415",
+     "f90849b2ce2c873f6d940c0aed39c1e110111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0xfffe, -78, {0x00, 0x00, 0x00}, 0xef,
+     "48464b4a233105aa37b0da7490c8bfe2d7a9bc94101112131415",
+     "f90849b2ce2c86c1936af20b12c7951410111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0xffff, -78, {0x00, 0x00, 0x00}, 0x14,
+     "48464b4ab2a7950058214b85ffde188abff38bfb101112131415",
+     "f90849b2ce2c5cc0926bf39ac9c6933210111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0000, -77, {0x00, 0x00, 0x00}, 0x39,
+     "48464b4ae4c04ef286ef19aec9f4a7b4a9057f38101112131415",
+     "f90849b2ce2c873f6d940d0aed397afd10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x0001, -77, {0x00, 0x00, 0x00}, 0x5e,
+     "48464b4a7b38b8029f5882dd38203a7a7f4188f2101112131415",
+     "f90849b2ce2c793e6c950cf412388b7010111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x007f, -77, {0x00, 0x00, 0x00}, 0x83,
+     "48464b4a7b75de370f5882dd3829a95176584276101112131415",
+     "f90849b2ce2cdc4012eb721ac946aa4910111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0080, -77, {0x00, 0x00, 0x00}, 0xa8,
+     "48464b4a16ff9cc054bde7609bb443f4e9a5fd54101112131415",
+     "f90849b2ce2c07bfed148d8aedb9f89a10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x00ff, -77, {0x00, 0x00, 0x00}, 0xcd,
+     "48464b4a230f06aa37b0da7590afa7fbf0c2d674101112131415",
+     "f90849b2ce2c87c0926bf20a12c6c54e10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x0100, -77, {0x00, 0x00, 0x00}, 0xf2,
+     "48464b4a6992c949216a94cb46299451763869b0101112131415",
+     "f90849b2ce2ca33f6d940d65c9398d5610111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x1234, -77, {0x00, 0x00, 0x00}, 0x17,
+     "48464b4aff8527d76bd4fe59b46253383d076c6e101112131415",
+     "f90849b2ce2cb30b59a0393eed0ddb3d10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x7fff, -77, {0x00, 0x00, 0x00}, 0x3c,
+     "48464b4a99f87c20c13a64fb16391d81664868cd101112131415",
+     "f90849b2ce2c87c0926bf20a12c6c54e10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x8000, -77, {0x00, 0x00, 0x00}, 0x61,
+     "48464b4ae16d511169f21cb3cef1acb9ae00dfd0101112131415",
+     "f90849b2ce2ca33f6d940d65c9398d5610111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0xfffe, -77, {0x00, 0x00, 0x00}, 0x86,
+     "48464b4a9e558238cc355ff813454c575c24f17a101112131415",
+     "f90849b2ce2c79c1936af3f4edc734c310111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0xffff, -77, {0x00, 0x00, 0x00}, 0xab,
+     "48464b4a23f506aa37b0da7590afa7fbf0c278bc101112131415",
+     "f90849b2ce2c87c0926bf20a12c6c54e10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x0000, -75, {0x00, 0x00, 0x01}, 0xd0,
+     "48464b4a69b4c949216a94c946299451763b1253101112131415",
+     "f90849b2ce2ca23e6c950a64c839ad5310111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0000, -75, {0x00, 0x01, 0xf4}, 0xf5,
+     "48464b4ae4fc4ef286ef19b4c9f4a7b4aa5152b4101112131415",
+     "f90849b2ce2c73cb9961fffe1939858310111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x0000, -75, {0x00, 0x03, 0xe8}, 0x1a,
+     "48464b4a7bfcb7029f5882d73817826381f2f438101112131415",
+     "f90849b2ce2c90d7857fe31dfa39f8c210111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x0001, -75, {0x00, 0x00, 0x01}, 0x3f,
+     "48464b4a512fe2a1f982ac215e768410257826a4101112131415",
+     "f90849b2ce2ca33f6d940b65c838461510111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0001, -75, {0x00, 0x01, 0xf4}, 0x64,
+     "48464b4a16bb1bc054bde7629bbdbdcfe388ead5101112131415",
+     "f90849b2ce2c72ca9860feff19386ec510111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x0001, -75, {0x00, 0x03, 0xe8}, 0x89,
+     "48464b4a23d310aa37b0da6f90c8d2e2d2913cd5101112131415",
+     "f90849b2ce2c91d6847ee21cfa38138410111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x007f, -75, {0x00, 0x00, 0x01}, 0xae,
+     "48464b4a8f7cf26b3b446eeb243dd57d622b6e38101112131415",
+     "f90849b2ce2cdd4113ea751bc8468a4c10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x007f, -75, {0x00, 0x01, 0xf4}, 0xd3,
+     "48464b4a9ea00138cc355ffa134cc66c5221dab4101112131415",
+     "f90849b2ce2c0cb4e61e80811946a29c10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x007f, -75, {0x00, 0x03, 0xe8}, 0xf8,
+     "48464b4ae1044468f9f21cb1ceff83ab914a518d101112131415",
+     "f90849b2ce2cefa8fa009c62fa46dfdd10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x0080, -75, {0x00, 0x00, 0x01}, 0x1d,
+     "48464b4a511161a1f982ac215e6ffe3b30654679101112131415",
+     "f90849b2ce2c22beec158ae4c8b92f3410111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0080, -75, {0x00, 0x01, 0xf4}, 0x42,
+     "48464b4affb0b3d76bd4fe5bb4ad3ccdf1c037f4101112131415",
+     "f90849b2ce2cf34b19e17f7e19b907e410111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x0080, -75, {0x00, 0x03, 0xe8}, 0x67,
+     "48464b4a23a98faa37b0da6f90c150e9d388a920101112131415",
+     "f90849b2ce2c105705ff639dfab97aa510111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x00ff, -75, {0x00, 0x00, 0x01}, 0x8c,
+     "48464b4a8f5a726b3b446eeb244b336f545d9e9a101112131415",
+     "f90849b2ce2c5dc1936af59bc8c6082b10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x00ff, -75, {0x00, 0x01, 0xf4}, 0xb1,
+     "48464b4ae438c7f286ef19b4c9f4eab4aa51b043101112131415",
+     "f90849b2ce2c8c34669e000119c620fb10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x00ff, -75, {0x00, 0x03, 0xe8}, 0xd6,
+     "48464b4a7bc05e029f5882d738173f6381f28ff8101112131415",
+     "f90849b2ce2c6f287a801ce2fac65dba10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x0100, -75, {0x00, 0x00, 0x01}, 0xfb,
+     "48464b4a8fa9a36b3b446eeb244b6e6f545d63fd101112131415",
+     "f90849b2ce2ca23e6c950a64c839ad5310111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0100, -75, {0x00, 0x01, 0xf4}, 0x20,
+     "48464b4a16771cc054bde7629bc2f5e6dc839098101112131415",
+     "f90849b2ce2c73cb9961fffe1939858310111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x0100, -75, {0x00, 0x03, 0xe8}, 0x45,
+     "48464b4a23870faa37b0da6f90afeafbe99a9f07101112131415",
+     "f90849b2ce2c90d7857fe31dfa39f8c210111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x1234, -75, {0x00, 0x00, 0x01}, 0x6a,
+     "48464b4a5102eda1f982ac215eb8e5cee32607ec101112131415",
+     "f90849b2ce2c960a58a13e50c80d0c9310111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x1234, -75, {0x00, 0x01, 0xf4}, 0x8f,
+     "48464b4ae10f7df589f21cb1ce48755e549dbb01101112131415",
+     "f90849b2ce2c47ffad55cbca190d244310111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x1234, -75, {0x00, 0x03, 0xe8}, 0xb4,
+     "48464b4a9980c520c13a64f91600ad969ed91f8f101112131415",
+     "f90849b2ce2ca4e3b14bd729fa0d590210111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x7fff, -75, {0x00, 0x00, 0x01}, 0xd9,
+     "48464b4a8f87726b3b446eeb244b336f545d4f36101112131415",
+     "f90849b2ce2c5dc1936af59bc8c6082b10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x7fff, -75, {0x00, 0x01, 0xf4}, 0xfe,
+     "48464b4a234006b347b0da6f90afa7fbef9694bc101112131415",
+     "f90849b2ce2c8c34669e000119c620fb10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x7fff, -75, {0x00, 0x03, 0xe8}, 0x23,
+     "48464b4a236d06aa37b0da6f90afa7fbe99a8780101112131415",
+     "f90849b2ce2c6f287a801ce2fac65dba10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x8000, -75, {0x00, 0x00, 0x01}, 0x48,
+     "48464b4a51e4e1a1f982ac215e813c291e93e3a5101112131415",
+     "f90849b2ce2ca23e6c950a64c839ad5310111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x8000, -75, {0x00, 0x01, 0xf4}, 0x6d,
+     "48464b4a7b07b75bef5882d73817826387fea4cb101112131415",
+     "f90849b2ce2c73cb9961fffe1939858310111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x8000, -75, {0x00, 0x03, 0xe8}, 0x92,
+     "48464b4a7b84b7029f5882d73817826381f2ede7101112131415",
+     "f90849b2ce2c90d7857fe31dfa39f8c210111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0xfffe, -75, {0x00, 0x00, 0x01}, 0xb7,
+     "48464b4a51a733a1f982ac215e768d1025781756101112131415",
+     "f90849b2ce2c5cc0926bf49ac8c7e36d10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0xfffe, -75, {0x00, 0x01, 0xf4}, 0xdc,
+     "48464b4a231e05b347b0da6f90c8bfe2d89dde57101112131415",
+     "f90849b2ce2c8d35679f010019c7cbbd10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0xfffe, -75, {0x00, 0x03, 0xe8}, 0x01,
+     "48464b4a234b05aa37b0da6f90c8bfe2d291ed23101112131415",
+     "f90849b2ce2c6e297b811de3fac7b6fc10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0xffff, -75, {0x00, 0x00, 0x01}, 0x26,
+     "48464b4a8f04726b3b446eeb244b336f545ddd71101112131415",
+     "f90849b2ce2c5dc1936af59bc8c6082b10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0xffff, -75, {0x00, 0x01, 0xf4}, 0x4b,
+     "48464b4a990b7c3dd13a64f916391d81651c1ea5101112131415",
+     "f90849b2ce2c8c34669e000119c620fb10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0xffff, -75, {0x00, 0x03, 0xe8}, 0x70,
+     "48464b4ae17cc468f9f21cb1cef1e5b9ab58ba1b101112131415",
+     "f90849b2ce2c6f287a801ce2fac65dba10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x0000, -73, {0x00, 0x00, 0x01}, 0x95,
+     "48464b4a5189e1a1f982ac1f5e813c291e934b63101112131415",
+     "f90849b2ce2ca23e6c950864c839db6a10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0000, -73, {0x00, 0x01, 0xf4}, 0xba,
+     "48464b4a23040fb347b0da7190afeafbef96b6b2101112131415",
+     "f90849b2ce2c73cb9961fdfe1939f3ba10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x0000, -73, {0x00, 0x03, 0xe8}, 0xdf,
+     "48464b4a16141c9d24bde7649bc2f5e6de8f7901101112131415",
+     "f90849b2ce2c90d7857fe11dfa398efb10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x0001, -73, {0x00, 0x00, 0x01}, 0x04,
+     "48464b4a8fe2a46b3b446eed243446466b36df22101112131415",
+     "f90849b2ce2ca33f6d940965c838302c10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0001, -73, {0x00, 0x01, 0xf4}, 0x29,
+     "48464b4a7bcbb85bef5882d938203a7a80f57e13101112131415",
+     "f90849b2ce2c72ca9860fcff193818fc10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x0001, -73, {0x00, 0x03, 0xe8}, 0x4e,
+     "48464b4ae4534d6bf6ef19b2c90b0f9d9756a148101112131415",
+     "f90849b2ce2c91d6847ee01cfa3865bd10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x007f, -73, {0x00, 0x00, 0x01}, 0x73,
+     "48464b4a8f31f26b3b446eed243dd57d622bc692101112131415",
+     "f90849b2ce2cdd4113ea771bc846fc7510111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x007f, -73, {0x00, 0x01, 0xf4}, 0x98,
+     "48464b4a23e286b347b0da7190c141e9ddac906f101112131415",
+     "f90849b2ce2c0cb4e61e82811946d4a510111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x007f, -73, {0x00, 0x03, 0xe8}, 0xbd,
+     "48464b4affdb62861bd4fe5db4ad25cdff640ea3101112131415",
+     "f90849b2ce2cefa8fa009e62fa46a9e410111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x0080, -73, {0x00, 0x00, 0x01}, 0xe2,
+     "48464b4a517a61a1f982ac1f5e6ffe3b3065b427101112131415",
+     "f90849b2ce2c22beec1588e4c8b9590d10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0080, -73, {0x00, 0x01, 0xf4}, 0x07,
+     "48464b4ae187d1f589f21cafceff8eab9feee8be101112131415",
+     "f90849b2ce2cf34b19e17d7e19b971dd10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x0080, -73, {0x00, 0x03, 0xe8}, 0x2c,
+     "48464b4a9eeb1425bc355ffc134cdb6c600543e3101112131415",
+     "f90849b2ce2c105705ff619dfab90c9c10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x00ff, -73, {0x00, 0x00, 0x01}, 0x51,
+     "48464b4a8f0f726b3b446eed244b336f545d9670101112131415",
+     "f90849b2ce2c5dc1936af79bc8c67e1210111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x00ff, -73, {0x00, 0x01, 0xf4}, 0x76,
+     "48464b4a23b806b347b0da7190afa7fbef964df2101112131415",
+     "f90849b2ce2c8c34669e020119c656c210111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x00ff, -73, {0x00, 0x03, 0xe8}, 0x9b,
+     "48464b4a16d0f99d24bde7649bc2bce6de8fdbf2101112131415",
+     "f90849b2ce2c6f287a801ee2fac62b8310111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x0100, -73, {0x00, 0x00, 0x01}, 0xc0,
+     "48464b4a515ce1a1f982ac1f5e813c291e939a7f101112131415",
+     "f90849b2ce2ca23e6c950864c839db6a10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0100, -73, {0x00, 0x01, 0xf4}, 0xe5,
+     "48464b4a7b8fb75bef5882d93817826387fedde1101112131415",
+     "f90849b2ce2c73cb9961fdfe1939f3ba10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x0100, -73, {0x00, 0x03, 0xe8}, 0x0a,
+     "48464b4ae48f4e6bf6ef19b2c9f4a7b4b05d3b05101112131415",
+     "f90849b2ce2c90d7857fe11dfa398efb10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x1234, -73, {0x00, 0x00, 0x01}, 0x2f,
+     "48464b4a69d79549216a94c746d0bda6cb8e3ebc101112131415",
+     "f90849b2ce2c960a58a13c50c80d7aaa10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x1234, -73, {0x00, 0x01, 0xf4}, 0x54,
+     "48464b4a23963bb347b0da719086371c125f3f90101112131415",
+     "f90849b2ce2c47ffad55c9ca190d527a10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x1234, -73, {0x00, 0x03, 0xe8}, 0x79,
+     "48464b4a9e36c825bc355ffc1303b4999bdec069101112131415",
+     "f90849b2ce2ca4e3b14bd529fa0d2f3b10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x7fff, -73, {0x00, 0x00, 0x01}, 0x9e,
+     "48464b4ae11ec41169f21cafcef1e5b9ae03bab6101112131415",
+     "f90849b2ce2c5dc1936af79bc8c67e1210111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x7fff, -73, {0x00, 0x01, 0xf4}, 0xc3,
+     "48464b4a99937c3dd13a64f716391d81651c677f101112131415",
+     "f90849b2ce2c8c34669e020119c656c210111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x7fff, -73, {0x00, 0x03, 0xe8}, 0xe8,
+     "48464b4aff06e2861bd4fe5db49bc3df0576ed3a101112131415",
+     "f90849b2ce2c6f287a801ee2fac62b8310111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x8000, -73, {0x00, 0x00, 0x01}, 0x0d,
+     "48464b4a69f9c949216a94c746299451763b1a75101112131415",
+     "f90849b2ce2ca23e6c950864c839db6a10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x8000, -73, {0x00, 0x01, 0xf4}, 0x32,
+     "48464b4a237c0fb347b0da7190afeafbef96af01101112131415",
+     "f90849b2ce2c73cb9961fdfe1939f3ba10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x8000, -73, {0x00, 0x03, 0xe8}, 0x57,
+     "48464b4a168c1c9d24bde7649bc2f5e6de8f80b2101112131415",
+     "f90849b2ce2c90d7857fe11dfa398efb10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0xfffe, -73, {0x00, 0x00, 0x01}, 0x7c,
+     "48464b4a7b165d370f5882d93820277a7f422bee101112131415",
+     "f90849b2ce2c5cc0926bf69ac8c7955410111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0xfffe, -73, {0x00, 0x01, 0xf4}, 0xa1,
+     "48464b4a7b535d5bef5882d93820277a80f5afc5101112131415",
+     "f90849b2ce2c8d35679f030019c7bd8410111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0xfffe, -73, {0x00, 0x03, 0xe8}, 0xc6,
+     "48464b4ae4cbc86bf6ef19b2c90b029d97569092101112131415",
+     "f90849b2ce2c6e297b811fe3fac7c0c510111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0xffff, -73, {0x00, 0x00, 0x01}, 0xeb,
+     "48464b4ab2e4950058214b80ffde188abff0986d101112131415",
+     "f90849b2ce2c5dc1936af79bc8c67e1210111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0xffff, -73, {0x00, 0x01, 0xf4}, 0x10,
+     "48464b4a235a06b347b0da7190afa7fbef96033a101112131415",
+     "f90849b2ce2c8c34669e020119c656c210111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0xffff, -73, {0x00, 0x03, 0xe8}, 0x35,
+     "48464b4aff63e2861bd4fe5db49bc3df05768505101112131415",
+     "f90849b2ce2c6f287a801ee2fac62b8310111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 0, 0x3129, -128, {0x00, 0x00, 0x00}, 0x7f,
+     "48464b4a1cba2ddeaeb7e149942b578d725e3bb7101112131415",
+     "f90849b2ce2c8a1647bd174cc910b6cf10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 0, 0x412c, -128, {0xff, 0xff, 0xff}, 0xb4,
+     "48464b4a9980ad3dd13a64cc17c5fcc6cb91e032101112131415",
+     "f90849b2ce2c5413bdb8edd912ea8dcd10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 0, 0x512f, -128, {0x80, 0x7f, 0x01}, 0xe9,
+     "48464b4ae1f57468f9f21c84cf5098564a2e6a83101112131415",
+     "f90849b2ce2c569140c510db1396900210111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x6132, -128, {0x00, 0x00, 0x00}, 0x1e,
+     "48464b4a99d6c759313a64cc163e89585d23456b101112131415",
+     "f90849b2ce2c910d5fa60c57c90b786110111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x7135, -128, {0xff, 0xff, 0xff}, 0x53,
+     "48464b4affc128d76bd4fe66b4c0fe89ce684e62101112131415",
+     "f90849b2ce2c4d0aa7a1f4c012f395ee10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x8138, -128, {0x80, 0x7f, 0x01}, 0x88,
+     "48464b4a0adb309130c9f35ba7197a239d4b8523101112131415",
+     "f90849b2ce2c418654d207cc1381999810111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 255, 0x913b, -128, {0x00, 0x00, 0x00}, 0xbd,
+     "48464b4affdb1ebb8bd4fe6660ad11cdf2dc908f101112131415",
+     "f90849b2ce2c9804aaaf055ec902bef110111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 255, 0xa13e, -128, {0xff, 0xff, 0xff}, 0xf2,
+     "48464b4a69928b6d016a94fccac8afad52940b36101112131415",
+     "f90849b2ce2c460150aaffcb12f885f310111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 255, 0xb141, -128, {0x80, 0x7f, 0x01}, 0x27,
+     "48464b4ab2983f39c8214bb31346b2c2cea87f4a101112131415",
+     "f90849b2ce2c38ffd1ab7eb513f882e810111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 0, 0xc144, 0, {0x00, 0x00, 0x00}, 0x5c,
+     "48464b4a7839f63a125b856d3818c760852965d8101112131415",
+     "f90849b2ce2ce77b2ad0fa21c97ddd3e10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 0, 0xd147, 0, {0xff, 0xff, 0xff}, 0x91,
+     "48464b4a1ce057ba4eb7e1c994b735c2a7837813101112131415",
+     "f90849b2ce2c3f78d6d306b212818da210111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 0, 0xe14a, 0, {0x80, 0x7f, 0x01}, 0xc6,
+     "48464b4ae4cb146bf6ef1901cc8849a00872f5b7101112131415",
+     "f90849b2ce2c33f425a0f5be13f381d410111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0xf14d, 0, {0x00, 0x00, 0x00}, 0xfb,
+     "48464b4a8fa9e06b3b446e562499332106c03ce9101112131415",
+     "f90849b2ce2cee7220d9f328c974315310111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x0150, 0, {0xff, 0xff, 0xff}, 0x30,
+     "48464b4a07567bcf63ccf6deac7b0e4479530cfe101112131415",
+     "f90849b2ce2c286fc2c411a51296843810111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0x1153, 0, {0x80, 0x7f, 0x01}, 0x65,
+     "48464b4a078b7e8e13ccf6deacc8246246b242e4101112131415",
+     "f90849b2ce2c2aed3fb9eca713ea99f710111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 255, 0x2156, 0, {0x00, 0x00, 0x00}, 0x9a,
+     "48464b4a070081b383ccf6de68901fda0fa92f37101112131415",
+     "f90849b2ce2cf569c7c2e833c96fd50010111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 255, 0x3159, 0, {0xff, 0xff, 0xff}, 0xcf,
+     "48464b4a073584cf63ccf6de68da38e3d8b27642101112131415",
+     "f90849b2ce2c216637cd18ac129f42a810111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 255, 0x415c, 0, {0x80, 0x7f, 0x01}, 0x04,
+     "48464b4a8fe2cf16ab446e56f09924a127cf413c101112131415",
+     "f90849b2ce2c25e2ccb6e3a813e534f910111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 0, 0x515f, 127, {0x00, 0x00, 0x00}, 0x39,
+     "48464b4ae4c0271666ef19facc4aa85e53af8e81101112131415",
+     "f90849b2ce2cfc6031cb9e3ac966d27410111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 0, 0x6162, 127, {0xff, 0xff, 0xff}, 0x6e,
+     "48464b4a1cab74ba4eb7e132942fca3a3f1b876e101112131415",
+     "f90849b2ce2c1a5df3f65c9712a48f8210111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 0, 0x7165, 127, {0x80, 0x7f, 0x01}, 0xa3,
+     "48464b4a7852d5ffa25b858e381b7bddc32553ff101112131415",
+     "f90849b2ce2c1cdb0a8fa59113dc2f5e10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x8168, 127, {0x00, 0x00, 0x00}, 0xd8,
+     "48464b4ab2f3280058214bc8ff5a152e4387849d101112131415",
+     "f90849b2ce2ccb5705fca90dc951337310111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 3, 0x916b, 127, {0xff, 0xff, 0xff}, 0x0d,
+     "48464b4a69f9e06d016a947f46c85cad529400f0101112131415",
+     "f90849b2ce2c1354f9ff559e12ad63ef10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 3, 0xa16e, 127, {0x80, 0x7f, 0x01}, 0x42,
+     "48464b4affb051861bd4fe15b4ad564d2bdbace0101112131415",
+     "f90849b2ce2c17d00284ae9a13d715be10111213141516171819"},
+    {{0x24, 0x6f, 0x28, 0x1a, 0x3c}, 255, 0xb171, 127, {0x00, 0x00, 0x00}, 0x77,
+     "48464b4a0ab077e8c0c9f3206b9535e70cccccd9101112131415",
+     "f90849b2ce2cd24ee0e5b014c94801ad10111213141516171819"},
+    {{0x00, 0x00, 0x00, 0x00, 0x00}, 255, 0xc174, 127, {0xff, 0xff, 0xff}, 0xac,
+     "48464b4affca67d76bd4fe15609845a1c6601c2b101112131415",
+     "f90849b2ce2c0c4b1ae04a8112b23aaf10111213141516171819"},
+    {{0xff, 0xff, 0xff, 0xff, 0xff}, 255, 0xd177, 127, {0x80, 0x7f, 0x01}, 0xe1,
+     "48464b4a99b50420c13a64affa39b501bf4b2e28101112131415",
+     "f90849b2ce2c0ec9e79db78313ce276010111213141516171819"},
+    {{0xfe, 0x64, 0x27, 0xb3, 0x01}, 148, 0xce6a, -76, {0xa5, 0xab, 0x2d}, 0xac,
+     "48464b4affca4d858bd4fe5a45655f865f9d98b7101112131415",
+     "f90849b2ce2c3eddbd784d293ef665ca10111213141516171819"},
+    {{0x10, 0x31, 0x4f, 0x09, 0x8c}, 3, 0x1dda, -10, {0xcd, 0x2b, 0x8b}, 0x29,
+     "48464b4a7bcb816bdf58821838de01d1981ac283101112131415",
+     "f90849b2ce2cc6a33cee196a762ea0ab10111213141516171819"},
+    {{0xda, 0xc5, 0xbc, 0x82, 0x00}, 3, 0x12f1, 5, {0x09, 0x7a, 0x96}, 0xe4,
+     "48464b4ae4edbd48c6ef1904c9888419030b73ad101112131415",
+     "f90849b2ce2c3a510a89dca8a1c190da10111213141516171819"},
+    {{0x17, 0xcf, 0x59, 0xf3, 0xa9}, 3, 0x5192, -100, {0x8a, 0xda, 0xb6}, 0x28,
+     "48464b4ae4b1dc03c6ef199dc963c6c38800262f101112131415",
+     "f90849b2ce2cb491496a06e14c21b35810111213141516171819"},
+    {{0x06, 0xbf, 0x49, 0x0c, 0xbe}, 250, 0xdaaa, 72, {0x1e, 0x50, 0x3d}, 0x53,
+     "48464b4affc18ddddbd4fe1e5b9b68f534a18df7101112131415",
+     "f90849b2ce2c16b603536122d68d4f8410111213141516171819"},
+    {{0xfe, 0xb4, 0xfc, 0x2b, 0xc8}, 3, 0x1d28, 92, {0x29, 0x3b, 0x01}, 0xaa,
+     "48464b4a0afd4092f0c9f3ffa77027613cf6a148101112131415",
+     "f90849b2ce2c503f4486cb971238c87e10111213141516171819"},
+    {{0xf1, 0x50, 0x26, 0x72, 0xab}, 3, 0x55c1, -97, {0x3c, 0x71, 0x7f}, 0x96,
+     "48464b4a995e5a2e213a64cf1698c2da14e47e78101112131415",
+     "f90849b2ce2cc8bdd35b9fe463c471b610111213141516171819"},
+    {{0x09, 0x32, 0xc8, 0x60, 0xa0}, 3, 0xd384, 104, {0xc8, 0xa2, 0x1f}, 0x65,
+     "48464b4a078bafd853ccf606acdafbd82392e98f101112131415",
+     "f90849b2ce2c156cf6ad4da3fb75fb9f10111213141516171819"},
+    {{0x92, 0x04, 0x97, 0x23, 0x49}, 40, 0xee97, -76, {0x3a, 0xab, 0xbd}, 0xfb,
+     "48464b4a8fa91ab9db446eea39f52c360feda1ce101112131415",
+     "f90849b2ce2c3f2f6c152024c294b70f10111213141516171819"},
+    {{0x67, 0x1c, 0x2b, 0x18, 0x6d}, 3, 0xa572, 5, {0x56, 0x58, 0x93}, 0xd9,
+     "48464b4a8f87f5aecb446e5b24e3486584171224101112131415",
+     "f90849b2ce2c01888c2d5af7191d8cb810111213141516171819"},
+    {{0x69, 0x0c, 0x82, 0x49, 0x63}, 3, 0x6fb8, -18, {0xc7, 0x84, 0x70}, 0x2c,
+     "48464b4a9eeb3c8fcc355f251339ea38fc70fef9101112131415",
+     "f90849b2ce2c2630a5d898cef44680a810111213141516171819"},
+    {{0x4c, 0xb9, 0xc5, 0x9f, 0x9b}, 3, 0x06bf, -79, {0x56, 0xb8, 0xaf}, 0xca,
+     "48464b4aff28a213dbd4fe57b4101890070849d6101112131415",
+     "f90849b2ce2cdb797d3c1fa30ed02e4510111213141516171819"},
+    {{0x6d, 0xfd, 0x8e, 0x95, 0xe6}, 95, 0xd959, -14, {0xed, 0x7b, 0xab}, 0x6c,
+     "48464b4ae47525ddf6ef196fa5bd95563965df60101112131415",
+     "f90849b2ce2c1820c31dbe052b8d7d7110111213141516171819"},
+    {{0x51, 0xfc, 0x5e, 0x85, 0xcc}, 3, 0x3dad, 62, {0x60, 0x9c, 0x04}, 0xff,
+     "48464b4a0a28bbfb30c9f3e1a76fa7e596f66f0d101112131415",
+     "f90849b2ce2c7ff6c4a1295fb8f40c3310111213141516171819"},
+    {{0x03, 0x10, 0xdc, 0x03, 0x4d}, 3, 0xe84f, -36, {0x1c, 0xfe, 0x06}, 0x9a,
+     "48464b4a07007ad273ccf6baac44ccaa4133f501101112131415",
+     "f90849b2ce2ccd6a24232b53e86a5cb010111213141516171819"},
+    {{0xe2, 0x3d, 0x60, 0x34, 0x7e}, 3, 0x7abd, -60, {0x2e, 0x08, 0xec}, 0x3f,
+     "48464b4a512f76e32982acd05e5ab40e19bb6e99101112131415",
+     "f90849b2ce2c34403ccd2b66e3aa116110111213141516171819"},
+    {{0x5e, 0x2a, 0xe5, 0xb6, 0x4f}, 218, 0x96ac, -76, {0x0c, 0x09, 0x81}, 0x7f,
+     "48464b4a1cbab2046eb7e17d5a82c4a57e7e8945101112131415",
+     "f90849b2ce2cf41e99b0270d32990a3810111213141516171819"},
+    {{0x9e, 0x6a, 0x6d, 0x6d, 0x92}, 3, 0xec3d, -84, {0x25, 0x42, 0x07}, 0x90,
+     "48464b4a78859de0125b85c135a4ec3137d83317101112131415",
+     "f90849b2ce2c232057ec285a7421edab10111213141516171819"},
+    {{0xe0, 0xa6, 0x66, 0x1f, 0x2a}, 3, 0x41f6, 22, {0x9f, 0x2b, 0xf1}, 0x95,
+     "48464b4a51892be5b982ac7e5ed3f0d4a551959e101112131415",
+     "f90849b2ce2c60a76ab8afabfc50112310111213141516171819"},
+    {{0x90, 0x59, 0x17, 0xfd, 0xf6}, 3, 0xbfc4, 111, {0x6f, 0xd9, 0x1b}, 0xe1,
+     "48464b4a99b555cd213a649f164712b82f37829e101112131415",
+     "f90849b2ce2cc88fb2920e8c6692f9b610111213141516171819"},
+    {{0xf5, 0xee, 0x72, 0xcf, 0x59}, 168, 0x93ec, 96, {0x0b, 0x4e, 0xd1}, 0x8a,
+     "48464b4a16e1089334bde72f42aed5e51d7866bc101112131415",
+     "f90849b2ce2c4f09fbe7e3d9c9dec40a10111213141516171819"},
+    {{0x6c, 0x73, 0x57, 0xf8, 0x66}, 3, 0xca44, -126, {0x0b, 0x08, 0x67}, 0x51,
+     "48464b4a8f0fe7a32b446ed8244bba785cbb437e101112131415",
+     "f90849b2ce2cc8174ebf1f5ae676591d10111213141516171819"},
+    {{0xf6, 0x88, 0x25, 0x46, 0x60}, 3, 0x24dc, 65, {0x77, 0x39, 0xb3}, 0x9e,
+     "48464b4ae11ea55f09f21cc5ce06df13ce261f78101112131415",
+     "f90849b2ce2c1e2702c290eda892e79d10111213141516171819"},
+    {{0x4f, 0xe6, 0xa2, 0xc7, 0x88}, 3, 0xf33c, 27, {0x06, 0xe6, 0x1d}, 0xba,
+     "48464b4a230443fa27b0dadd903e775e3338ec25101112131415",
+     "f90849b2ce2ce9184c5384cdbf03016c10111213141516171819"},
+    {{0xa1, 0x1f, 0x44, 0xfd, 0x35}, 115, 0xb3c4, -76, {0xf7, 0xcd, 0xe4}, 0x9e,
+     "48464b4ae11e8d9699f21cb0be479ff031331557101112131415",
+     "f90849b2ce2c06e83d792a35a80ac3bc10111213141516171819"},
+    {{0xd7, 0xc9, 0xa6, 0xf4, 0x3f}, 3, 0xb7f0, -67, {0x8b, 0xa5, 0x86}, 0x12,
+     "48464b4a0778dba623ccf65bac2227ffdad14dc1101112131415",
+     "f90849b2ce2c26c21b4775b5bc42aaff10111213141516171819"},
+    {{0x13, 0x38, 0x7b, 0x57, 0x40}, 3, 0xe457, -128, {0x60, 0xa5, 0x82}, 0x1a,
+     "48464b4a7bfc066edf5882ea382b7befefd0f5d2101112131415",
+     "f90849b2ce2c418ab8e4ebe77c0eece610111213141516171819"},
+    {{0x70, 0x0b, 0x58, 0x31, 0x08}, 3, 0x2565, 101, {0x41, 0xe8, 0x1a}, 0xf5,
+     "48464b4ae4fc31e286ef19e4c9efcf78d6a086d4101112131415",
+     "f90849b2ce2c88011203a47e871d06ad10111213141516171819"},
+    {{0x67, 0x7d, 0x07, 0xca, 0xaf}, 202, 0x8705, 127, {0x49, 0xcb, 0x08}, 0x2c,
+     "48464b4a9eeb979d3c355fb4ccd2b29f06afc877101112131415",
+     "f90849b2ce2ced7ba952cc7a8275a70e10111213141516171819"},
+    {{0x80, 0xa2, 0x48, 0x93, 0x46}, 3, 0x7ac0, -94, {0x4a, 0x1e, 0x83}, 0x42,
+     "48464b4affb0f357cbd4fe48b4d2075ebf165907101112131415",
+     "f90849b2ce2c44362ec95febeeb31d2110111213141516171819"},
+    {{0x3f, 0x8b, 0x6f, 0xd7, 0xb9}, 3, 0x2974, 77, {0x4c, 0x97, 0x0e}, 0xe6,
+     "48464b4a1c338ae3ceb7e10491b7284d8fdc946c101112131415",
+     "f90849b2ce2cc209177989fbdc012ba110111213141516171819"},
+    {{0xa3, 0x3a, 0x28, 0x8c, 0x60}, 3, 0x65e2, 88, {0x28, 0x0a, 0x7e}, 0xae,
+     "48464b4a8f7c85eaeb446e7e2482955013c90e4d101112131415",
+     "f90849b2ce2cb88bf1027aac30f375bf10111213141516171819"},
+    {{0x02, 0xf8, 0x38, 0xef, 0x99}, 223, 0x73b9, -76, {0x67, 0x17, 0x6f}, 0x8e,
+     "48464b4affec9cd91bd4fe5a8065ae865f9dbeb0101112131415",
+     "f90849b2ce2c538e6755dc2480e74da510111213141516171819"},
+    {{0x49, 0x1e, 0xf8, 0x03, 0x40}, 3, 0x5467, -11, {0x9f, 0x7f, 0xc5}, 0x5a,
+     "48464b4a991af476e13a6439163e9e03c8e4bd22101112131415",
+     "f90849b2ce2c6c02cf49e9b661c10b0610111213141516171819"},
+    {{0xdf, 0xc8, 0x0d, 0x74, 0x26}, 3, 0xaba1, -5, {0xb6, 0x69, 0x36}, 0xf8,
+     "48464b4ae104f248c9f21c7bce5e1cbad6850c1b101112131415",
+     "f90849b2ce2ccf1efa6ad255042ea63510111213141516171819"},
+    {{0xbe, 0x32, 0xca, 0x44, 0x18}, 3, 0x14f2, -34, {0xf8, 0xdd, 0x7a}, 0xf0,
+     "48464b4a99c487df013a640e16989396c0e3a9bb101112131415",
+     "f90849b2ce2cb14fe5c1e8b02933b64a10111213141516171819"},
+    {{0xb0, 0x86, 0x50, 0x23, 0x3c}, 238, 0xd46a, -27, {0xd1, 0x0e, 0x02}, 0x05,
+     "48464b4ab2b62a7438214b4e24a73aacf448ae61101112131415",
+     "f90849b2ce2c5f86e8f233e45f82414610111213141516171819"},
+    {{0x6f, 0x1c, 0x5b, 0xf6, 0x68}, 3, 0x7799, 68, {0x2c, 0xcf, 0x3e}, 0x51,
+     "48464b4a8f0f0ca6cb446e9a244bc5a3195480cf101112131415",
+     "f90849b2ce2c4fb4cafc5db1bc8c31b710111213141516171819"},
+    {{0x44, 0xca, 0xf1, 0xd6, 0x59}, 3, 0x60c3, -123, {0x49, 0xd5, 0x31}, 0xb8,
+     "48464b4a07deee1323ccf663ac22f6c14a88f1fa101112131415",
+     "f90849b2ce2c31849fb3c93298b3bbd410111213141516171819"},
+    {{0x97, 0x30, 0x83, 0x97, 0xfd}, 3, 0x487d, 31, {0x81, 0xbe, 0x70}, 0x21,
+     "48464b4a0747686653ccf6fdac6de7bcacbc4f3f101112131415",
+     "f90849b2ce2c1db36027ac370ac5065410111213141516171819"},
+    {{0x79, 0x01, 0x3c, 0x0a, 0x6f}, 65, 0x53a1, -76, {0x83, 0xf8, 0x05}, 0x26,
+     "48464b4a8f044490db446eea62f556360fed9805101112131415",
+     "f90849b2ce2c5a188bc8aeaf911b026410111213141516171819"},
+    {{0xed, 0xf8, 0xc5, 0xb3, 0xeb}, 3, 0xecda, -40, {0xc9, 0xe9, 0x5b}, 0xcc,
+     "48464b4a0a17d29f30c9f383a76f727c81db8b1f101112131415",
+     "f90849b2ce2ceb77ecfce7735b2aafce10111213141516171819"},
+    {{0x6b, 0x8b, 0xd8, 0x6a, 0x56}, 3, 0x2353, 27, {0xf4, 0x31, 0x2e}, 0x90,
+     "48464b4a78850773725b85723543a5218940603a101112131415",
+     "f90849b2ce2c91b610d8d8fca89ef21f10111213141516171819"},
+    {{0x86, 0x1f, 0x41, 0x48, 0xbc}, 3, 0xde3b, 39, {0x37, 0x25, 0x8f}, 0x24,
+     "48464b4aff521e5d7bd4fecdb4ad113ed545950d101112131415",
+     "f90849b2ce2cb5bcd9052da1e435376610111213141516171819"},
+    {{0x9e, 0xf1, 0x46, 0x0f, 0xed}, 13, 0xf3e0, 73, {0xb4, 0x82, 0x7f}, 0x21,
+     "48464b4a0747cb6d13ccf627b6275237fa7f614a101112131415",
+     "f90849b2ce2c8614fc8968640c6dcce410111213141516171819"},
+    {{0xa2, 0x41, 0x65, 0x2c, 0x39}, 3, 0x5e3c, 72, {0x66, 0x97, 0x30}, 0x52,
+     "48464b4ae15a859349f21cccce8035fca221e913101112131415",
+     "f90849b2ce2c2955610ffa477f638bbb10111213141516171819"},
+    {{0x1e, 0x54, 0x5c, 0xee, 0xa3}, 3, 0xc663, 41, {0x67, 0x45, 0x27}, 0xf3,
+     "48464b4a516bc077c982acbd5ea93142492d5880101112131415",
+     "f90849b2ce2cdd1c2995d31ad43dc5c310111213141516171819"},
+    {{0xc8, 0xbb, 0x5f, 0x47, 0xc5}, 3, 0x998a, -19, {0xe1, 0x26, 0xe3}, 0x8b,
+     "48464b4a07f1b597d3ccf68bac9f84eae67b23ec101112131415",
+     "f90849b2ce2c26b704db3ad8c652106b10111213141516171819"},
+    {{0xae, 0xb6, 0xb3, 0xa1, 0x07}, 1, 0x0c2a, -76, {0x4d, 0x35, 0x60}, 0xe9,
+     "48464b4ae1f5779739f21cb0d04789f03133cb6b101112131415",
+     "f90849b2ce2c633825eb40f6235e759b10111213141516171819"},
+    {{0xa0, 0xeb, 0xcc, 0xc0, 0xfd}, 3, 0x0813, -77, {0x28, 0xd2, 0x6b}, 0xde,
+     "48464b4a07443e2f03ccf651ac9fab33b243f1d9101112131415",
+     "f90849b2ce2c5f6f153e75992602856d10111213141516171819"},
+    {{0x03, 0x48, 0x6f, 0xb1, 0xa0}, 3, 0x25f3, 6, {0x3a, 0x37, 0x80}, 0x12,
+     "48464b4a0778ded2a3ccf6e4acda0ee6d01f3ffa101112131415",
+     "f90849b2ce2cf7761ed0cb316ef050f410111213141516171819"},
+    {{0xe4, 0xe2, 0x6d, 0x5e, 0x71}, 3, 0x21ee, 54, {0x51, 0x39, 0x1e}, 0x1d,
+     "48464b4a511143e17982ac9e5e8166f8457a7333101112131415",
+     "f90849b2ce2c939e9d5d781817861cd810111213141516171819"},
+    {{0xbf, 0xf7, 0x7f, 0xec, 0x1e}, 19, 0x7380, 25, {0x90, 0x2a, 0x51}, 0xac,
+     "48464b4affcab3461bd4feefc4ad3c5d08eb2b5e101112131415",
+     "f90849b2ce2ce97eac6f762c03290db110111213141516171819"},
+    {{0x0e, 0x5e, 0x21, 0x13, 0xb8}, 3, 0x898b, 0, {0x68, 0x5d, 0x0d}, 0x04,
+     "48464b4a8fe21e450b446e562448ec8ab44ee923101112131415",
+     "f90849b2ce2c0fd1eb4f38d2eeda8b8e10111213141516171819"},
+    {{0x72, 0x77, 0x78, 0x6d, 0x20}, 3, 0x83b3, 73, {0x62, 0x0f, 0x58}, 0xe6,
+     "48464b4a1c33c328beb7e10091ca8c38daf73f27101112131415",
+     "f90849b2ce2c1eb686701c96c7e8804510111213141516171819"},
+    {{0x8c, 0xce, 0xe1, 0x8a, 0xda}, 3, 0xbeaa, -56, {0x31, 0x09, 0x9e}, 0xe5,
+     "48464b4a7b8f11cfaf5882223817ecb28fc04b6a101112131415",
+     "f90849b2ce2c3f3a59a942f0ffa2adae10111213141516171819"},
+    {{0xd0, 0x8b, 0x75, 0xcb, 0x24}, 173, 0x9d07, -76, {0x66, 0x64, 0x12}, 0xc4,
+     "48464b4a1c15178aceb7e17d2f8229a57e7e1aab101112131415",
+     "f90849b2ce2c424cd6e51f942f58ea6410111213141516171819"},
+    {{0xbf, 0x98, 0x81, 0xe2, 0x31}, 3, 0x05d9, -41, {0x66, 0x71, 0xc7}, 0x9f,
+     "48464b4afffdfc46fbd4febdb410e200a0e0ffd1101112131415",
+     "f90849b2ce2c264773fb778c95868c5110111213141516171819"},
+    {{0x06, 0xb7, 0x3d, 0x38, 0xef}, 3, 0x7d02, 29, {0x53, 0x43, 0x8f}, 0xa7,
+     "48464b4a695fc767516a9461461d1eaabfb973ca101112131415",
+     "f90849b2ce2c0ce1e05a2e30646827be10111213141516171819"},
+    {{0x95, 0x1e, 0x70, 0x67, 0xf5}, 3, 0xde4c, 23, {0xd3, 0xfc, 0x8b}, 0x01,
+     "48464b4a234b534057b0dad190c114aec22df9eb101112131415",
+     "f90849b2ce2cd52baaaf6ed3f3a67b5610111213141516171819"},
+    {{0xe9, 0xb8, 0x05, 0x8a, 0xa1}, 237, 0xe04c, -83, {0xce, 0xd1, 0x5f}, 0x64,
+     "48464b4a16bb68a7e4bde77a85b4ff8e9aecb9ed101112131415",
+     "f90849b2ce2c7de2905600a15bbb768e10111213141516171819"},
+    {{0x43, 0x00, 0x32, 0x9a, 0x9e}, 3, 0x8db1, 93, {0xa0, 0x14, 0x5c}, 0x4a,
+     "48464b4a9e094379cc355f9213043434ad4133a4101112131415",
+     "f90849b2ce2c2972806d0ee7f22860e410111213141516171819"},
+    {{0xa9, 0xd3, 0x58, 0xc2, 0x48}, 3, 0x7ad4, 0, {0xd4, 0x56, 0x26}, 0x83,
+     "48464b4a7b7583b4bf58826a38cda8012cde5643101112131415",
+     "f90849b2ce2cdc199f304c2b62391f0c10111213141516171819"},
+    {{0xe3, 0xd5, 0x62, 0xa9, 0x36}, 3, 0xb0de, 8, {0x40, 0x30, 0xf9}, 0xae,
+     "48464b4a8f7c512a8b446e4e24484fb2671a8260101112131415",
+     "f90849b2ce2c43584a8391f8f7a7666e10111213141516171819"},
+};
+
+}  // namespace golden
+}  // namespace hiflying_light
+}  // namespace esphome
@@ -0,0 +1,31 @@
+#pragma once
+
+// 主機建置沒有 BLE 堆疊，廣播由 SimulatedAdvertiser 模擬
+// test_advertiser 定義 USE_ESP32 並使用 tests/host/idf 中假的 GAP API
+
+#ifdef USE_ESP32
+#include <esp_gap_ble_api.h>
+
+#include <vector>
+
+namespace esphome {
+namespace esp32_ble {
+
+class GAPEventHandler {
+ public:
+  virtual void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) = 0;
+};
+
+class ESP32BLE {
+ public:
+  bool is_active() { return true; }
+  void register_gap_event_handler(GAPEventHandler *handler) { this->gap_event_handlers.push_back(handler); }
+
+  std::vector<GAPEventHandler *> gap_event_handlers;
+};
+
+extern ESP32BLE *global_ble;
+
+}  // namespace esp32_ble
+}  // namespace esphome
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <set>
+
+namespace esphome {
+namespace light {
+
+enum class ColorMode { BRIGHTNESS, COLOR_TEMPERATURE };
+
+// 只包含 HiFlyingLightOutputBase 使用的部分
+class LightColorValues {
+ public:
+  ColorMode get_color_mode() const { return this->color_mode; }
+  float get_color_temperature() const { return this->color_temperature; }
+  bool operator==(const LightColorValues &other) const {
+    return this->brightness == other.brightness && this->color_temperature == other.color_temperature &&
+           this->color_mode == other.color_mode;
+  }
+
+  ColorMode color_mode{ColorMode::BRIGHTNESS};
+  float brightness{0.0f};
+  float color_temperature{300.0f};
+};
+
+class LightState {
+ public:
+  void current_values_as_brightness(float *brightness) { *brightness = this->current_values.brightness; }
+
+  LightColorValues current_values;
+  LightColorValues remote_values;
+};
+
+class LightTraits {
+ public:
+  void set_supported_color_modes(std::set<ColorMode> modes) { this->modes_ = modes; }
+  void set_min_mireds(float mireds) { this->min_mireds_ = mireds; }
+  void set_max_mireds(float mireds) { this->max_mireds_ = mireds; }
+
+ protected:
+  std::set<ColorMode> modes_;
+  float min_mireds_{0.0f};
+  float max_mireds_{0.0f};
+};
+
+class LightOutput {
+ public:
+  virtual ~LightOutput() = default;
+  virtual LightTraits get_traits() = 0;
+  virtual void setup_state(LightState * /*state*/) {}
+  virtual void write_state(LightState *state) = 0;
+};
+
+}  // namespace light
+}  // namespace esphome
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "light_output.h"
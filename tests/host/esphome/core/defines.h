@@ -0,0 +1,3 @@
+#pragma once
+
+// 主機建置: 功能開關由 tests/CMakeLists.txt 以編譯選項提供 (裝置上由 ESPHome 產生此檔案)
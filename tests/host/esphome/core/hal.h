@@ -0,0 +1,13 @@
+#pragma once
+
+// 主機建置的時鐘: millis() 由 delay() 推進的虛擬時鐘，micros() 為實際時間 (用於計時統計)
+
+#include <cstdint>
+
+namespace esphome {
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+
+}  // namespace esphome
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// 與裝置上相同，全域的 abs() 也有浮點數多載
+#include <math.h>
+
+namespace esphome {
+
+std::string format_hex_pretty(const uint8_t *data, size_t length);
+uint32_t random_uint32();
+
+class Mutex {
+ public:
+  void lock() { this->mutex_.lock(); }
+  bool try_lock() { return this->mutex_.try_lock(); }
+  void unlock() { this->mutex_.unlock(); }
+
+ private:
+  std::mutex mutex_;
+};
+
+class LockGuard {
+ public:
+  explicit LockGuard(Mutex &mutex) : mutex_(mutex) { this->mutex_.lock(); }
+  ~LockGuard() { this->mutex_.unlock(); }
+
+ private:
+  Mutex &mutex_;
+};
+
+}  // namespace esphome
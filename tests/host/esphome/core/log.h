@@ -0,0 +1,24 @@
+#pragma once
+
+// 主機建置的日誌: 只輸出不低於 host_log_level 的訊息 (預設 WARN，測試可調整)
+
+namespace esphome {
+
+enum HostLogLevel { HOST_LOG_ERROR = 1, HOST_LOG_WARN, HOST_LOG_INFO, HOST_LOG_CONFIG, HOST_LOG_DEBUG, HOST_LOG_VERBOSE };
+
+extern int host_log_level;
+void host_log(int level, const char *tag, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+}  // namespace esphome
+
+#define ESP_LOGE(tag, ...) ::esphome::host_log(::esphome::HOST_LOG_ERROR, tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) ::esphome::host_log(::esphome::HOST_LOG_WARN, tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) ::esphome::host_log(::esphome::HOST_LOG_INFO, tag, __VA_ARGS__)
+#define ESP_LOGCONFIG(tag, ...) ::esphome::host_log(::esphome::HOST_LOG_CONFIG, tag, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) ::esphome::host_log(::esphome::HOST_LOG_DEBUG, tag, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) ::esphome::host_log(::esphome::HOST_LOG_VERBOSE, tag, __VA_ARGS__)
+#define ESP_LOGVV(tag, ...) ::esphome::host_log(::esphome::HOST_LOG_VERBOSE, tag, __VA_ARGS__)
+
+#define YESNO(b) ((b) ? "YES" : "NO")
+#define LOG_SENSOR(prefix, type, obj) ((void) (obj))
+#define LOG_UPDATE_INTERVAL(this) ((void) (this))
@@ -0,0 +1,42 @@
+#pragma once
+
+// 主機建置的 preferences: 以記憶體模擬 flash，save() 只寫入待寫區，sync() 後才算寫入 flash
+// (與裝置上延遲寫入的行為相同)，測試可用 power_loss() 丟棄尚未同步的資料
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+
+class ESPPreferenceObject {
+ public:
+  ESPPreferenceObject() = default;
+  explicit ESPPreferenceObject(uint32_t key) : key_(key) {}
+
+  template<typename T> bool save(const T *src) { return this->save_(reinterpret_cast<const uint8_t *>(src), sizeof(T)); }
+  template<typename T> bool load(T *dest) { return this->load_(reinterpret_cast<uint8_t *>(dest), sizeof(T)); }
+
+ protected:
+  bool save_(const uint8_t *data, size_t length);
+  bool load_(uint8_t *data, size_t length);
+
+  uint32_t key_{0};
+};
+
+class ESPPreferences {
+ public:
+  template<typename T> ESPPreferenceObject make_preference(uint32_t type) { return ESPPreferenceObject(type); }
+  bool sync();
+
+  // 測試用
+  uint32_t get_syncs() const { return this->syncs_; }
+  void power_loss();
+  void clear();
+
+ protected:
+  uint32_t syncs_{0};
+};
+
+extern ESPPreferences *global_preferences;
+
+}  // namespace esphome
@@ -0,0 +1,98 @@
+// 主機建置的 ESPHome 核心替代實現 (時鐘、日誌、亂數、preferences)
+
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace esphome {
+
+static uint32_t host_millis = 0;
+
+uint32_t millis() { return host_millis; }
+
+uint32_t micros() {
+  using namespace std::chrono;
+  return uint32_t(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void delay(uint32_t ms) { host_millis += ms; }
+
+std::string format_hex_pretty(const uint8_t *data, size_t length) {
+  std::string result;
+  char buffer[4];
+  for (size_t i = 0; i < length; i++) {
+    std::snprintf(buffer, sizeof(buffer), i == 0 ? "%02X" : ".%02X", data[i]);
+    result += buffer;
+  }
+  return result;
+}
+
+uint32_t random_uint32() {
+  static std::mt19937 generator(20261017);
+  return generator();
+}
+
+int host_log_level = HOST_LOG_WARN;
+
+void host_log(int level, const char *tag, const char *format, ...) {
+  if (level > host_log_level)
+    return;
+  std::printf("[%s] ", tag);
+  va_list args;
+  va_start(args, format);
+  std::vprintf(format, args);
+  va_end(args);
+  std::printf("\n");
+}
+
+// flash 內容與尚未同步的寫入
+static std::map<uint32_t, std::vector<uint8_t>> flash_data;
+static std::map<uint32_t, std::vector<uint8_t>> pending_data;
+
+bool ESPPreferenceObject::save_(const uint8_t *data, size_t length) {
+  pending_data[this->key_].assign(data, data + length);
+  return true;
+}
+
+bool ESPPreferenceObject::load_(uint8_t *data, size_t length) {
+  auto it = pending_data.find(this->key_);
+  if (it == pending_data.end()) {
+    it = flash_data.find(this->key_);
+    if (it == flash_data.end())
+      return false;
+  }
+  if (it->second.size() != length)
+    return false;
+  std::memcpy(data, it->second.data(), length);
+  return true;
+}
+
+bool ESPPreferences::sync() {
+  for (auto &entry : pending_data)
+    flash_data[entry.first] = entry.second;
+  pending_data.clear();
+  this->syncs_++;
+  return true;
+}
+
+void ESPPreferences::power_loss() { pending_data.clear(); }
+
+void ESPPreferences::clear() {
+  flash_data.clear();
+  pending_data.clear();
+  this->syncs_ = 0;
+}
+
+static ESPPreferences host_preferences;
+ESPPreferences *global_preferences = &host_preferences;
+
+}  // namespace esphome
@@ -0,0 +1,114 @@
+#pragma once
+
+// 假的 ESP-IDF GAP API (只用於 test_advertiser): 記錄每個呼叫，測試再以 fake_gap_event() 送出控制器的完成事件
+// 只包含 hiflying_advertiser.cpp 使用的型別與函數
+
+#include <cstdint>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+typedef uint8_t esp_bd_addr_t[6];
+
+typedef enum {
+  ESP_BT_STATUS_SUCCESS = 0,
+  ESP_BT_STATUS_FAIL,
+  ESP_BT_STATUS_UNSUPPORTED = 6,
+} esp_bt_status_t;
+
+typedef enum {
+  ESP_GAP_BLE_EXT_ADV_SET_RAND_ADDR_COMPLETE_EVT = 22,
+  ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT,
+  ESP_GAP_BLE_EXT_ADV_DATA_SET_COMPLETE_EVT,
+  ESP_GAP_BLE_EXT_ADV_START_COMPLETE_EVT = 26,
+  ESP_GAP_BLE_EXT_ADV_STOP_COMPLETE_EVT,
+} esp_gap_ble_cb_event_t;
+
+typedef union {
+  struct ble_ext_adv_set_params_cmpl_evt_param {
+    esp_bt_status_t status;
+    uint8_t instance;
+  } ext_adv_set_params;
+  struct ble_ext_adv_start_cmpl_evt_param {
+    esp_bt_status_t status;
+    uint8_t instance_num;
+    uint8_t instance[10];
+  } ext_adv_start;
+} esp_ble_gap_cb_param_t;
+
+// 傳統廣播
+#define ADV_TYPE_NONCONN_IND 0x03
+#define BLE_ADDR_TYPE_RANDOM 0x01
+#define ADV_CHNL_ALL 0x07
+#define ADV_FILTER_ALLOW_SCAN_ANY_CON_ANY 0x00
+
+typedef struct {
+  uint16_t adv_int_min;
+  uint16_t adv_int_max;
+  uint8_t adv_type;
+  uint8_t own_addr_type;
+  esp_bd_addr_t peer_addr;
+  uint8_t peer_addr_type;
+  uint8_t channel_map;
+  uint8_t adv_filter_policy;
+} esp_ble_adv_params_t;
+
+esp_err_t esp_ble_gap_set_rand_addr(esp_bd_addr_t rand_addr);
+esp_err_t esp_ble_gap_config_adv_data_raw(uint8_t *raw_data, uint32_t raw_data_len);
+esp_err_t esp_ble_gap_start_advertising(esp_ble_adv_params_t *adv_params);
+esp_err_t esp_ble_gap_stop_advertising();
+
+// 擴展廣播
+#define ESP_BLE_GAP_SET_EXT_ADV_PROP_LEGACY_NONCONN 0x10
+#define ESP_BLE_GAP_EXT_ADV_TX_PWR_NO_PREFERENCE 127
+#define ESP_BLE_GAP_PRI_PHY_1M 1
+#define ESP_BLE_GAP_PHY_1M 1
+
+typedef struct {
+  uint16_t type;
+  uint32_t interval_min;
+  uint32_t interval_max;
+  uint8_t channel_map;
+  uint8_t own_addr_type;
+  uint8_t peer_addr_type;
+  esp_bd_addr_t peer_addr;
+  uint8_t filter_policy;
+  int8_t tx_power;
+  uint8_t primary_phy;
+  uint8_t max_skip;
+  uint8_t secondary_phy;
+  uint8_t sid;
+  bool scan_req_notif;
+} esp_ble_gap_ext_adv_params_t;
+
+typedef struct {
+  uint8_t instance;
+  int duration;
+  int max_events;
+} esp_ble_gap_ext_adv_t;
+
+esp_err_t esp_ble_gap_ext_adv_set_params(uint8_t instance, const esp_ble_gap_ext_adv_params_t *params);
+esp_err_t esp_ble_gap_ext_adv_set_rand_addr(uint8_t instance, esp_bd_addr_t rand_addr);
+esp_err_t esp_ble_gap_config_ext_adv_data_raw(uint8_t instance, uint16_t length, const uint8_t *data);
+esp_err_t esp_ble_gap_ext_adv_start(uint8_t num_adv, const esp_ble_gap_ext_adv_t *ext_adv);
+esp_err_t esp_ble_gap_ext_adv_stop(uint8_t num_adv, const uint8_t *ext_adv_inst);
+
+// 測試用: 每個 API 的呼叫次數、每個廣播集 set_params 的同步回傳值與送出 GAP 事件
+struct FakeGap {
+  int legacy_addresses{0};
+  int legacy_payloads{0};
+  int legacy_starts{0};
+  int legacy_stops{0};
+  int ext_set_params{0};
+  int ext_addresses{0};
+  int ext_payloads{0};
+  int ext_starts{0};
+  int ext_stops{0};
+  uint8_t last_ext_instance{0xff};
+  esp_err_t set_params_result[2]{ESP_OK, ESP_OK};
+};
+
+extern FakeGap fake_gap;
+void fake_gap_reset();
+void fake_gap_event(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param);
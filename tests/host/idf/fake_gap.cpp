@@ -0,0 +1,73 @@
+#include "esp_gap_ble_api.h"
+#include "esphome/components/esp32_ble/ble.h"
+
+FakeGap fake_gap;
+
+esp_err_t esp_ble_gap_set_rand_addr(esp_bd_addr_t /*rand_addr*/) {
+  fake_gap.legacy_addresses++;
+  return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_config_adv_data_raw(uint8_t * /*raw_data*/, uint32_t /*raw_data_len*/) {
+  fake_gap.legacy_payloads++;
+  return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_start_advertising(esp_ble_adv_params_t * /*adv_params*/) {
+  fake_gap.legacy_starts++;
+  return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_stop_advertising() {
+  fake_gap.legacy_stops++;
+  return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_ext_adv_set_params(uint8_t instance, const esp_ble_gap_ext_adv_params_t * /*params*/) {
+  fake_gap.ext_set_params++;
+  fake_gap.last_ext_instance = instance;
+  return instance < 2 ? fake_gap.set_params_result[instance] : ESP_FAIL;
+}
+
+esp_err_t esp_ble_gap_ext_adv_set_rand_addr(uint8_t instance, esp_bd_addr_t /*rand_addr*/) {
+  fake_gap.ext_addresses++;
+  fake_gap.last_ext_instance = instance;
+  return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_config_ext_adv_data_raw(uint8_t instance, uint16_t /*length*/, const uint8_t * /*data*/) {
+  fake_gap.ext_payloads++;
+  fake_gap.last_ext_instance = instance;
+  return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_ext_adv_start(uint8_t /*num_adv*/, const esp_ble_gap_ext_adv_t *ext_adv) {
+  fake_gap.ext_starts++;
+  fake_gap.last_ext_instance = ext_adv[0].instance;
+  return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_ext_adv_stop(uint8_t num_adv, const uint8_t * /*ext_adv_inst*/) {
+  fake_gap.ext_stops += num_adv;
+  return ESP_OK;
+}
+
+void fake_gap_reset() {
+  fake_gap = FakeGap{};
+  esphome::esp32_ble::global_ble->gap_event_handlers.clear();
+}
+
+// 與 ESPHome 的 esp32_ble 相同，依序交給每個已註冊的處理器
+void fake_gap_event(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
+  for (auto *handler : esphome::esp32_ble::global_ble->gap_event_handlers)
+    handler->gap_event_handler(event, param);
+}
+
+namespace esphome {
+namespace esp32_ble {
+
+static ESP32BLE fake_ble;
+ESP32BLE *global_ble = &fake_ble;
+
+}  // namespace esp32_ble
+}  // namespace esphome
@@ -0,0 +1,59 @@
+#pragma once
+
+// 端到端模擬的共用工具: 元件在主機上建置，廣播由 SimulatedAdvertiser 以虛擬時鐘記錄
+// tick() 同時推進 millis() (元件的時鐘) 與模擬器的時鐘 (仲裁器的時鐘)
+
+#include "esphome/core/hal.h"
+#include "hiflying_light.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace hiflying_test {
+
+using namespace esphome::hiflying_light;
+
+inline SimulatedAdvertiser *simulator() {
+  return static_cast<SimulatedAdvertiser *>(HiFlyingRadio::get()->get_advertiser());
+}
+
+template<typename T> inline void tick(const std::vector<T *> &components, uint32_t ms = 1) {
+  for (uint32_t i = 0; i < ms; i++) {
+    for (auto *component : components)
+      component->loop();
+    esphome::delay(1);
+    simulator()->advance(1);
+  }
+}
+
+// 執行直到所有命令發送完成，回傳經過的毫秒數
+template<typename T> inline uint32_t run_until_idle(const std::vector<T *> &components, uint32_t limit = 60000) {
+  uint32_t elapsed = 0;
+  do {
+    tick(components);
+    elapsed++;
+  } while (HiFlyingRadio::get()->pending() > 0 && elapsed < limit);
+  return elapsed;
+}
+
+// 延遲分佈 (ms)
+struct LatencyStats {
+  std::vector<uint32_t> samples;
+
+  void add(uint32_t ms) { this->samples.push_back(ms); }
+  void print(const char *name) {
+    if (this->samples.empty()) {
+      std::printf("  %-28s (no samples)\n", name);
+      return;
+    }
+    std::sort(this->samples.begin(), this->samples.end());
+    double sum = 0;
+    for (auto sample : this->samples)
+      sum += sample;
+    std::printf("  %-28s mean %7.1f ms  p95 %5u ms  max %5u ms  (%zu)\n", name, sum / this->samples.size(),
+                this->samples[this->samples.size() * 95 / 100], this->samples.back(), this->samples.size());
+  }
+};
+
+}  // namespace hiflying_test
@@ -0,0 +1,129 @@
+// ExtendedAdvertiser 的主機測試 (假的 GAP API): 控制器在完成事件中回報失敗時只使用集 0，不改用傳統廣播 API
+
+#include "check.h"
+
+#include "hiflying_advertiser.h"
+
+#include <memory>
+
+using namespace esphome::hiflying_light;
+
+static void send_status(esp_gap_ble_cb_event_t event, esp_bt_status_t status, uint8_t set) {
+  esp_ble_gap_cb_param_t param{};
+  if (event == ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT) {
+    param.ext_adv_set_params.status = status;
+    param.ext_adv_set_params.instance = set;
+  } else {
+    param.ext_adv_start.status = status;
+    param.ext_adv_start.instance_num = 1;
+    param.ext_adv_start.instance[0] = set;
+  }
+  fake_gap_event(event, &param);
+}
+
+// 一個廣播步驟 (與仲裁器相同的呼叫順序)
+static void advertise(Advertiser &advertiser, uint8_t set) {
+  const uint8_t address[6] = {1, 2, 3, 4, 5, 0xc6};
+  AdvFrame frame{};
+  advertiser.set_address(set, address);
+  advertiser.set_payload(set, frame, 31);
+  advertiser.start(set);
+}
+
+static void test_success() {
+  fake_gap_reset();
+  ExtendedAdvertiser advertiser;
+  CHECK(advertiser.setup());
+  CHECK_EQ(fake_gap.ext_set_params, 2);
+  send_status(ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT, ESP_BT_STATUS_SUCCESS, 0);
+  send_status(ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT, ESP_BT_STATUS_SUCCESS, 1);
+  CHECK_EQ(advertiser.num_sets(), 2);
+  CHECK(!advertiser.has_failed());
+
+  advertise(advertiser, 1);
+  send_status(ESP_GAP_BLE_EXT_ADV_START_COMPLETE_EVT, ESP_BT_STATUS_SUCCESS, 1);
+  CHECK_EQ(fake_gap.ext_starts, 1);
+  CHECK_EQ(fake_gap.last_ext_instance, 1);
+  CHECK_EQ(fake_gap.legacy_starts, 0);
+  CHECK_EQ(advertiser.num_sets(), 2);
+}
+
+// 集 0 的命令沒有送出: setup() 失敗時沒有留下處理器，銷毀後集 0 之前的事件也不會再交給它
+static void test_synchronous_failure() {
+  fake_gap_reset();
+  fake_gap.set_params_result[0] = ESP_FAIL;
+  auto advertiser = std::make_unique<ExtendedAdvertiser>();
+  CHECK(!advertiser->setup());
+  advertiser.reset();
+  CHECK(esphome::esp32_ble::global_ble->gap_event_handlers.empty());
+  send_status(ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT, ESP_BT_STATUS_SUCCESS, 0);
+}
+
+// 集 1 的命令沒有送出: 集 0 的完成事件仍會到達，廣播器保留並直接進入失敗狀態
+static void test_synchronous_failure_second_set() {
+  fake_gap_reset();
+  fake_gap.set_params_result[1] = ESP_FAIL;
+  ExtendedAdvertiser advertiser;
+  CHECK(advertiser.setup());
+  CHECK(advertiser.has_failed());
+  CHECK_EQ(advertiser.num_sets(), 1);
+  CHECK_EQ(esphome::esp32_ble::global_ble->gap_event_handlers.size(), 1u);
+  send_status(ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT, ESP_BT_STATUS_SUCCESS, 0);
+}
+
+// 命令已送出 (同步回傳成功) 但控制器拒絕廣播集參數: 兩種幀輪流使用集 0
+static void test_set_params_failure() {
+  fake_gap_reset();
+  ExtendedAdvertiser advertiser;
+  CHECK(advertiser.setup());
+  send_status(ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT, ESP_BT_STATUS_SUCCESS, 0);
+  send_status(ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT, ESP_BT_STATUS_UNSUPPORTED, 1);
+  CHECK(advertiser.has_failed());
+  CHECK_EQ(advertiser.num_sets(), 1);
+
+  advertise(advertiser, 0);
+  CHECK_EQ(fake_gap.ext_addresses, 1);
+  CHECK_EQ(fake_gap.ext_payloads, 1);
+  CHECK_EQ(fake_gap.ext_starts, 1);
+  CHECK_EQ(fake_gap.last_ext_instance, 0);
+  advertiser.stop(0);
+  advertise(advertiser, 1);
+  CHECK_EQ(fake_gap.last_ext_instance, 0);
+  advertiser.stop(1);
+  CHECK_EQ(fake_gap.ext_starts, 2);
+  CHECK_EQ(fake_gap.ext_stops, 3);
+  CHECK_EQ(fake_gap.legacy_addresses + fake_gap.legacy_payloads + fake_gap.legacy_starts + fake_gap.legacy_stops, 0);
+}
+
+// 開始廣播失敗: 已經在廣播的集在第一次停止時一起停止，之後只使用集 0
+static void test_start_failure() {
+  fake_gap_reset();
+  ExtendedAdvertiser advertiser;
+  CHECK(advertiser.setup());
+  send_status(ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT, ESP_BT_STATUS_SUCCESS, 0);
+  send_status(ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT, ESP_BT_STATUS_SUCCESS, 1);
+  advertise(advertiser, 0);
+  advertise(advertiser, 1);
+  send_status(ESP_GAP_BLE_EXT_ADV_START_COMPLETE_EVT, ESP_BT_STATUS_SUCCESS, 0);
+  send_status(ESP_GAP_BLE_EXT_ADV_START_COMPLETE_EVT, ESP_BT_STATUS_FAIL, 1);
+  CHECK(advertiser.has_failed());
+  CHECK_EQ(advertiser.num_sets(), 1);
+
+  advertiser.stop(0);
+  CHECK_EQ(fake_gap.ext_stops, 2);
+  advertise(advertiser, 1);
+  CHECK_EQ(fake_gap.ext_starts, 3);
+  CHECK_EQ(fake_gap.last_ext_instance, 0);
+  advertiser.stop(1);
+  CHECK_EQ(fake_gap.ext_stops, 3);
+  CHECK_EQ(fake_gap.legacy_starts, 0);
+}
+
+int main() {
+  test_success();
+  test_synchronous_failure();
+  test_synchronous_failure_second_set();
+  test_set_params_failure();
+  test_start_failure();
+  return hiflying_test::check_result("test_advertiser");
+}
@@ -0,0 +1,113 @@
+// 集線器的主機測試: 計數器租約在斷電後不會重用 (包括迴繞到 0 的租約結束值)、舊版記錄的轉換與封裝策略
+
+#include "check.h"
+#include "simulator.h"
+
+#include "hiflying_hub.h"
+
+using namespace esphome::hiflying_light;
+using esphome::global_preferences;
+
+// 租約結束值迴繞到 0 時重啟後仍從 0 開始，不會退回初始計數器而被燈具當作重放拒絕
+static void test_lease_wraps_to_zero() {
+  global_preferences->clear();
+  {
+    HiFlyingLightHub hub;
+    hub.set_counter(65500);
+    hub.set_counter_lease(36);
+    uint8_t index = hub.add_lamp(1, PROTOCOL_HF);
+    hub.setup();
+    hub.turn_on(index);
+    CHECK_EQ(global_preferences->get_syncs(), 1u);
+    HiFlyingRadio::get()->flush();
+  }
+  global_preferences->power_loss();
+
+  HiFlyingLightHub hub;
+  hub.set_counter(65500);
+  uint8_t index = hub.add_lamp(1, PROTOCOL_HF);
+  hub.setup();
+  auto *sim = hiflying_test::simulator();
+  sim->reset();
+  hub.turn_on(index);
+  HiFlyingRadio::get()->flush();
+  bool found = false;
+  for (size_t i = 0; i < sim->event_count(); i++) {
+    const SimEvent &event = sim->event(i);
+    if (event.type != SIM_PAYLOAD)
+      continue;
+    Packet packet;
+    std::copy(event.data.begin() + 5, event.data.begin() + 31, packet.begin());
+    DecodedCommand cmd;
+    if (decode_hf_packet(packet, cmd)) {
+      CHECK_EQ(cmd.counter, 0);
+      found = true;
+    }
+  }
+  CHECK(found);
+}
+
+// 舊版記錄 (0 表示未使用) 在 setup() 時轉換
+static void test_legacy_record() {
+  global_preferences->clear();
+  HubCountersV1 legacy{};
+  legacy[2] = 1234;
+  auto pref = global_preferences->make_preference<HubCountersV1>(0x48554221);
+  pref.save(&legacy);
+  global_preferences->sync();
+
+  HiFlyingLightHub hub;
+  hub.set_counter(7);
+  uint8_t migrated = hub.add_lamp(3, PROTOCOL_HF);
+  uint8_t fresh = hub.add_lamp(4, PROTOCOL_HF);
+  hub.setup();
+
+  auto *sim = hiflying_test::simulator();
+  const uint16_t expected[] = {1234 & 0xff, 7};
+  const uint8_t indexes[] = {migrated, fresh};
+  for (int i = 0; i < 2; i++) {
+    sim->reset();
+    hub.turn_on(indexes[i]);
+    HiFlyingRadio::get()->flush();
+    bool found = false;
+    for (size_t j = 0; j < sim->event_count(); j++) {
+      const SimEvent &event = sim->event(j);
+      Packet packet;
+      std::copy(event.data.begin() + 5, event.data.begin() + 31, packet.begin());
+      DecodedCommand cmd;
+      if (event.type == SIM_PAYLOAD && decode_hf_packet(packet, cmd)) {
+        CHECK_EQ(cmd.counter, expected[i]);
+        found = true;
+      }
+    }
+    CHECK(found);
+  }
+}
+
+static void test_framing() {
+  global_preferences->clear();
+  HiFlyingLightHub hub;
+  hub.set_framing(FRAMING_RAW);
+  uint8_t index = hub.add_lamp(5, PROTOCOL_DELI16);
+  hub.setup();
+  auto *sim = hiflying_test::simulator();
+  sim->reset();
+  hub.turn_on(index);
+  HiFlyingRadio::get()->flush();
+  bool found = false;
+  for (size_t i = 0; i < sim->event_count(); i++) {
+    const SimEvent &event = sim->event(i);
+    if (event.type == SIM_PAYLOAD) {
+      CHECK_EQ(event.length, 26);
+      found = true;
+    }
+  }
+  CHECK(found);
+}
+
+int main() {
+  test_lease_wraps_to_zero();
+  test_legacy_record();
+  test_framing();
+  return hiflying_test::check_result("test_hub");
+}
@@ -0,0 +1,185 @@
+// hiflying_protocol.h 的主機測試: 以優化前編碼器產生的基準輸出逐字節比對 HF/Deli16 封包，
+// 並檢查解碼往返與 AD 幀格式
+
+#include "alloc_hook.h"
+#include "check.h"
+#include "golden_vectors.h"
+
+#include "../components/hiflying_light/hiflying_protocol.h"
+#include "../components/hiflying_light/hiflying_reference.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace esphome::hiflying_light;
+
+// 加密表必須在編譯期完成 (static_assert 無法對執行期的值求值)
+static_assert(ENCRYPTION_TABLE[0] == golden::ENCRYPTION_TABLE[0] && ENCRYPTION_TABLE[15] == golden::ENCRYPTION_TABLE[15],
+              "ENCRYPTION_TABLE is not a compile-time constant matching the baseline");
+
+static void test_encryption_table() {
+  CHECK(ENCRYPTION_TABLE == golden::ENCRYPTION_TABLE);
+  CHECK(make_encryption_table() == golden::ENCRYPTION_TABLE);
+}
+
+static void test_whitening_mask() {
+  auto inner = make_whitening_mask<13>(63);
+  auto outer = make_whitening_mask<29>(37);
+  CHECK(inner == golden::WHITENING_63);
+  CHECK(outer == golden::WHITENING_37);
+  for (size_t i = 0; i < DELI16_WHITENING_MASK.size(); i++) {
+    uint8_t expected = golden::WHITENING_37[i] ^ (i >= 16 ? golden::WHITENING_63[i - 16] : 0);
+    CHECK_EQ(DELI16_WHITENING_MASK[i], expected);
+  }
+}
+
+// 白化與資料內容無關: 任意輸入經參考實現處理後都等於與預先計算的密鑰流 XOR
+static void test_whitening_any_data() {
+  uint32_t seed = 20261017;
+  for (int round = 0; round < 256; round++) {
+    std::vector<uint8_t> data(29);
+    for (auto &b : data) {
+      seed = seed * 1103515245 + 12345;
+      b = uint8_t(seed >> 16);
+    }
+    std::vector<uint8_t> expected = data;
+    reference::apply_bit_operation(expected, 29, 37);
+    auto mask = make_whitening_mask<29>(37);
+    for (size_t i = 0; i < data.size(); i++)
+      CHECK_EQ(uint8_t(data[i] ^ mask[i]), expected[i]);
+  }
+}
+
+static void test_crc16() {
+  uint8_t data[32];
+  for (int i = 0; i < 32; i++)
+    data[i] = golden::crc_input(i);
+  for (const auto &v : golden::CRC_VECTORS)
+    CHECK_EQ(calculate_crc16(data, v.length, 0), v.crc);
+}
+
+// 查表 (256 項或 16 項) 必須與逐位元計算一致
+static uint16_t crc16_update_bitwise(uint16_t crc, uint8_t byte_val, bool reflected) {
+  if (reflected) {
+    crc ^= byte_val;
+    for (int i = 0; i < 8; i++)
+      crc = (crc & 1) ? (crc >> 1) ^ CRC16_POLY_REFLECTED : crc >> 1;
+    return crc;
+  }
+  crc ^= uint16_t(byte_val) << 8;
+  for (int i = 0; i < 8; i++)
+    crc = (crc & 0x8000) ? uint16_t((crc << 1) ^ CRC16_POLY) : uint16_t(crc << 1);
+  return crc;
+}
+
+static void test_crc16_table() {
+  for (uint32_t crc = 0; crc < 0x10000; crc += 0x0101) {
+    for (int b = 0; b < 256; b++) {
+      CHECK_EQ(crc16_update(crc, b), crc16_update_bitwise(crc, b, false));
+      CHECK_EQ(crc16_update_reflected(crc, b), crc16_update_bitwise(crc, b, true));
+    }
+  }
+}
+
+static void test_golden_packets() {
+  for (const auto &v : golden::VECTORS) {
+    Packet hf = generate_hf_packet(v.mac, v.page, v.counter, v.ctrl_code, v.params, v.random);
+    Packet deli16 = generate_deli16_packet(v.mac, v.page, v.counter, v.ctrl_code, v.params);
+    if (!hiflying_test::equals_hex(hf, v.hf)) {
+      std::printf("HF mismatch: counter=0x%04x ctrl=%d\n", v.counter, v.ctrl_code);
+      hiflying_test::failures()++;
+    }
+    if (!hiflying_test::equals_hex(deli16, v.deli16)) {
+      std::printf("Deli16 mismatch: counter=0x%04x ctrl=%d\n", v.counter, v.ctrl_code);
+      hiflying_test::failures()++;
+    }
+  }
+}
+
+// 計數器 0xffff 之後迴繞到 0，封包只攜帶低 8 位
+static void test_counter_wrap() {
+  const std::array<uint8_t, 5> mac = {0x24, 0x6f, 0x28, 0x1a, 0x3c};
+  const std::array<uint8_t, 3> params = {0, 0x01, 0xf4};
+  uint16_t counter = 0xffff;
+  counter++;
+  CHECK_EQ(counter, 0);
+  CHECK(generate_hf_packet(mac, 3, counter, -75, params, 0x42) == generate_hf_packet(mac, 3, 0x0100, -75, params, 0x42));
+  CHECK(generate_deli16_packet(mac, 3, counter, -75, params) == generate_deli16_packet(mac, 3, 0x0100, -75, params));
+}
+
+static void test_decode_round_trip() {
+  for (const auto &v : golden::VECTORS) {
+    DecodedCommand command;
+    Packet hf = generate_hf_packet(v.mac, v.page, v.counter, v.ctrl_code, v.params, v.random);
+    CHECK(decode_hf_packet(hf, command));
+    CHECK_EQ(command.address[0], v.mac[0]);
+    CHECK_EQ(command.address[1], v.mac[1] & 0xf0);
+    CHECK_EQ(command.counter, v.counter & 0xff);
+    CHECK_EQ(command.ctrl_code, v.ctrl_code);
+    if (v.ctrl_code != -76)
+      CHECK(command.params == v.params);
+
+    Packet deli16 = generate_deli16_packet(v.mac, v.page, v.counter, v.ctrl_code, v.params);
+    CHECK(decode_deli16_packet(deli16, command, v.page));
+    CHECK_EQ(command.address[0], v.mac[0]);
+    CHECK_EQ(command.address[1], v.mac[1]);
+    CHECK_EQ(command.counter, v.counter & 0xff);
+    CHECK_EQ(command.ctrl_code, v.ctrl_code);
+    CHECK(command.params == v.params);
+
+    // 任一字節損壞時不應被當成有效命令
+    deli16[4] ^= 0x01;
+    CHECK(!decode_deli16_packet(deli16, command, v.page));
+  }
+}
+
+static void test_adv_frame() {
+  const auto &v = golden::VECTORS[0];
+  Packet hf = generate_hf_packet(v.mac, v.page, v.counter, v.ctrl_code, v.params, v.random);
+  AdvFrame frame = build_adv_frame(hf);
+  CHECK_EQ(frame[0], 0x02);
+  CHECK_EQ(frame[1], 0x01);
+  CHECK_EQ(frame[2], 0x01);
+  CHECK_EQ(frame[3], 0x1B);
+  CHECK_EQ(frame[4], 0x03);
+  CHECK(std::equal(hf.begin(), hf.end(), frame.begin() + 5));
+  CHECK_EQ(adv_pdu_airtime_us(frame.size()), 376u);
+}
+
+// 編碼路徑只使用固定大小的緩衝區，不應配置任何記憶體
+static void test_zero_allocation() {
+  const size_t before = hiflying_test::allocation_count();
+  for (const auto &v : golden::VECTORS) {
+    Packet hf = generate_hf_packet(v.mac, v.page, v.counter, v.ctrl_code, v.params, v.random);
+    Packet deli16 = generate_deli16_packet(v.mac, v.page, v.counter, v.ctrl_code, v.params);
+    AdvFrame frame = build_adv_frame(hf);
+    DecodedCommand command;
+    CHECK(decode_hf_packet(hf, command));
+    CHECK(decode_deli16_packet(deli16, command, v.page));
+    CHECK_EQ(frame[5], hf[0]);
+  }
+  CHECK_EQ(hiflying_test::allocation_count(), before);
+
+  // 確認掛鉤有效
+  auto *probe = new std::vector<uint8_t>(26);
+  CHECK(hiflying_test::allocation_count() > before);
+  delete probe;
+}
+
+int main() {
+  test_encryption_table();
+  test_whitening_mask();
+  test_whitening_any_data();
+  test_crc16();
+  test_crc16_table();
+  test_golden_packets();
+  test_counter_wrap();
+  test_decode_round_trip();
+  test_adv_frame();
+  test_zero_allocation();
+#ifdef USE_HIFLYING_LIGHT_CRC_NIBBLE_TABLE
+  return hiflying_test::check_result("test_protocol (nibble CRC table)");
+#else
+  return hiflying_test::check_result("test_protocol");
+#endif
+}
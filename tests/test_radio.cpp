@@ -0,0 +1,193 @@
+// 射頻仲裁器的主機測試: 待發送計數在丟棄、搶佔與發送完成時保持一致，submit() 沒有射頻任務時直接入隊，
+// 命令未發送就被丟棄時燈具的狀態快取失效，待發送的串流值被取消時不計入合併，場景突發在項目被丟棄時仍會結束，封包追蹤只清除已輸出的記錄
+
+#include "check.h"
+#include "simulator.h"
+
+using namespace esphome::hiflying_light;
+
+static void test_lane_full_drop() {
+  auto *radio = HiFlyingRadio::get();
+  uint32_t dropped = radio->get_dropped();
+  for (int i = 0; i < TX_LANE_DEPTH + 2; i++)
+    radio->enqueue(3, 3, 10);
+  CHECK_EQ(radio->pending(3), TX_LANE_DEPTH);
+  CHECK_EQ(radio->pending(), TX_LANE_DEPTH);
+  CHECK_EQ(radio->get_dropped() - dropped, 2u);
+  radio->flush();
+  CHECK_EQ(radio->pending(3), 0);
+  CHECK_EQ(radio->pending(), 0);
+}
+
+static void test_pool_full_drop() {
+  auto *radio = HiFlyingRadio::get();
+  uint32_t dropped = radio->get_dropped();
+  for (uint8_t lane = 1; lane <= TX_POOL_SIZE + 4; lane++)
+    radio->enqueue(lane, 3, 10);
+  CHECK_EQ(radio->pending(), TX_POOL_SIZE);
+  CHECK_EQ(radio->get_dropped() - dropped, 4u);
+  uint32_t lanes = 0;
+  for (uint8_t lane = 1; lane <= TX_POOL_SIZE + 4; lane++)
+    lanes += radio->pending(lane);
+  CHECK_EQ(lanes, uint32_t(TX_POOL_SIZE));
+  radio->flush();
+  CHECK_EQ(radio->pending(), 0);
+}
+
+static void test_preempt() {
+  auto *radio = HiFlyingRadio::get();
+  uint32_t preempted = radio->get_preempted();
+  radio->enqueue(5, 3, 10, 0);
+  radio->enqueue(5, 3, 10, 0);
+  radio->loop();  // 第一個命令開始發送
+  radio->preempt(5, 2, 0);
+  // 發送中的命令保留目前這一次重複，尚未發送的命令直接丟棄
+  CHECK_EQ(radio->pending(5), 1);
+  CHECK_EQ(radio->get_preempted() - preempted, 2u);
+  radio->flush();
+  CHECK_EQ(radio->pending(5), 0);
+  CHECK_EQ(radio->pending(), 0);
+}
+
+// 突發的第二個項目在通道佇列已滿時被丟棄，突發照樣結束並更新首尾間隔
+static void test_burst_entry_dropped() {
+  auto *radio = HiFlyingRadio::get();
+  uint8_t burst = radio->begin_burst(2);
+  radio->enqueue(8, 3, 10).burst = burst;
+  radio->loop();  // 第一個項目開始發送
+  radio->flush();
+  CHECK_EQ(radio->get_last_burst_spread(), 0u);
+  radio->enqueue(7, 3, 10).burst = burst;
+  for (int i = 0; i < TX_LANE_DEPTH; i++)
+    radio->enqueue(7, 3, 10);
+  CHECK(radio->get_last_burst_spread() > 0);
+  radio->flush();
+  CHECK_EQ(radio->pending(), 0);
+}
+
+static void test_submit_without_task() {
+  auto *radio = HiFlyingRadio::get();
+  CHECK(!radio->uses_task());
+  RadioCommand cmd{};
+  const uint8_t mac[5] = {0x24, 0x6f, 0x28, 0x1a, 0x3c};
+  std::copy(mac, mac + 5, cmd.mac);
+  cmd.counter = 0x1234;
+  cmd.ctrl_code = -75;
+  cmd.params[1] = 0x01;
+  cmd.params[2] = 0xf4;
+  cmd.lane = 7;
+  cmd.repeats = 2;
+  cmd.interval = 10;
+  cmd.protocol = PROTOCOL_DELI16;
+  cmd.framing = FRAMING_UUID_LIST;
+  CHECK(radio->submit(cmd));
+  CHECK_EQ(radio->pending(7), 1);
+
+  auto *sim = hiflying_test::simulator();
+  sim->reset();
+  radio->flush();
+  CHECK_EQ(radio->pending(7), 0);
+  // Deli16 沒有隨機字節，幀內容必須與直接編碼相同
+  AdvFrame expected = build_adv_frame(generate_deli16_packet({0x24, 0x6f, 0x28, 0x1a, 0x3c}, 3, 0x1234, -75,
+                                                             {0, 0x01, 0xf4}));
+  bool found = false;
+  for (size_t i = 0; i < sim->event_count(); i++) {
+    const SimEvent &event = sim->event(i);
+    if (event.type == SIM_PAYLOAD)
+      found |= event.data == expected;
+  }
+  CHECK(found);
+}
+
+static void test_lost_command_invalidates_cache() {
+  auto *radio = HiFlyingRadio::get();
+  HiFlyingLightComponent component;
+  component.set_instance_id(9);
+  component.setup();
+  std::vector<HiFlyingLightComponent *> components = {&component};
+  hiflying_test::run_until_idle(components);
+
+  component.set_brightness(500);
+  CHECK_EQ(radio->pending(9), 1);
+  uint8_t lost = radio->get_lost(9);
+  // 同一通道塞滿後，尚未發送的亮度命令被丟棄
+  for (int i = 0; i < TX_LANE_DEPTH; i++)
+    radio->enqueue(9, 3, 10);
+  CHECK_EQ(uint8_t(radio->get_lost(9) - lost), 1);
+  hiflying_test::run_until_idle(components);
+  CHECK_EQ(radio->pending(9), 0);
+  // 快取記錄的 500 從未發送，相同的值必須重新入隊
+  component.set_brightness(500);
+  CHECK_EQ(radio->pending(9), 1);
+  hiflying_test::run_until_idle(components);
+  component.set_brightness(500);
+  CHECK_EQ(radio->pending(9), 0);
+}
+
+// 待發送的亮度被與燈具相同的值取消時只計入 suppressed，被另一個會發送的值取代時才計入 coalesced
+static void test_stream_metrics() {
+  auto *radio = HiFlyingRadio::get();
+  HiFlyingLightComponent component;
+  component.set_instance_id(10);
+  component.setup();
+  std::vector<HiFlyingLightComponent *> components = {&component};
+  component.set_brightness(500);
+  hiflying_test::run_until_idle(components);
+
+  radio->enqueue(10, 3, 10);  // 通道忙碌，串流值留在槽位中
+  component.set_brightness(300);
+  component.set_brightness(500);
+  CHECK_EQ(component.get_coalesced(), 0u);
+  CHECK_EQ(component.get_suppressed(), 1u);
+  component.set_brightness(300);
+  component.set_brightness(200);
+  CHECK_EQ(component.get_coalesced(), 1u);
+  CHECK_EQ(component.get_suppressed(), 1u);
+  hiflying_test::run_until_idle(components);
+  CHECK_EQ(radio->pending(), 0);
+}
+
+static void test_trace_ring() {
+  PacketTrace<4> trace;
+  TraceRecord record{};
+  for (uint16_t i = 0; i < 6; i++) {
+    record.counter = i;
+    trace.push(record);
+  }
+  CHECK_EQ(trace.first(), 2u);
+  CHECK_EQ(trace.total(), 6u);
+  CHECK_EQ(trace.overwritten(), 2u);
+  CHECK(!trace.copy(1, record));
+  CHECK(trace.copy(2, record));
+  CHECK_EQ(record.counter, 2);
+
+  // 輸出期間寫入的記錄在清除後保留
+  uint32_t end = trace.total();
+  record.counter = 6;
+  trace.push(record);
+  trace.clear_until(end);
+  CHECK_EQ(trace.first(), 6u);
+  CHECK_EQ(trace.overwritten(), 0u);
+  CHECK(trace.copy(6, record));
+  CHECK_EQ(record.counter, 6);
+  CHECK(!trace.copy(5, record));
+
+  // 經由仲裁器: 輸出後清空
+  auto *radio = HiFlyingRadio::get();
+  radio->enqueue(11, 2, 10);
+  radio->flush();
+  radio->dump_trace();
+  radio->dump_trace();
+}
+
+int main() {
+  test_lane_full_drop();
+  test_pool_full_drop();
+  test_preempt();
+  test_burst_entry_dropped();
+  test_submit_without_task();
+  test_lost_command_invalidates_cache();
+  test_stream_metrics();
+  test_trace_ring();
+  return hiflying_test::check_result("test_radio");
+}